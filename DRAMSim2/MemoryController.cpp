@@ -967,6 +967,14 @@ MemoryController::~MemoryController()
 	{
 		delete returnTransaction[i];
 	}
+	for (size_t i=0; i<transactionQueue.size(); i++)
+	{
+		delete transactionQueue[i];
+	}
+	for (size_t i=0; i<writeDataToSend.size(); i++)
+	{
+		delete writeDataToSend[i];
+	}
 
 }
 //inserts a latency into the latency histogram
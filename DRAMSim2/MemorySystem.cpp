@@ -130,11 +130,16 @@ MemorySystem::MemorySystem(unsigned id, unsigned int megsOfMemory, CSVWriter &cs
 	DEBUG("CH. " <<systemID<<" TOTAL_STORAGE : "<< TOTAL_STORAGE << "MB | "<<NUM_RANKS<<" Ranks | "<< NUM_DEVICES <<" Devices per rank");
 
 
-	memoryController = new MemoryController(this, csvOut, dramsim_log);
-
 	// TODO: change to other vector constructor?
 	ranks = new vector<Rank *>();
 
+	createController();
+}
+
+void MemorySystem::createController()
+{
+	memoryController = new MemoryController(this, csvOut, dramsim_log);
+
 	for (size_t i=0; i<NUM_RANKS; i++)
 	{
 		Rank *r = new Rank(dramsim_log);
@@ -144,7 +149,32 @@ MemorySystem::MemorySystem(unsigned id, unsigned int megsOfMemory, CSVWriter &cs
 	}
 
 	memoryController->attachRanks(ranks);
+}
+
+void MemorySystem::deleteController()
+{
+	delete(memoryController);
+
+	for (size_t i=0; i<ranks->size(); i++)
+	{
+		delete (*ranks)[i];
+	}
+	ranks->clear();
+}
+
+//drops every queued transaction and brings the controller and ranks back to their power-on timing state
+void MemorySystem::reset()
+{
+	for (size_t i=0; i<pendingTransactions.size(); i++)
+	{
+		delete pendingTransactions[i];
+	}
+	pendingTransactions.clear();
 
+	deleteController();
+	createController();
+
+	currentClockCycle = 0;
 }
 
 
@@ -155,13 +185,7 @@ MemorySystem::~MemorySystem()
 //	ERROR("MEMORY SYSTEM DESTRUCTOR with ID "<<systemID);
 //	abort();
 
-	delete(memoryController);
-
-	for (size_t i=0; i<NUM_RANKS; i++)
-	{
-		delete (*ranks)[i];
-	}
-	ranks->clear();
+	deleteController();
 	delete(ranks);
 
 	if (VERIFICATION_OUTPUT)
@@ -62,6 +62,7 @@ public:
 	bool addTransaction(bool isWrite, uint64_t addr);
 	void printStats(bool finalStats);
 	bool WillAcceptTransaction();
+	void reset();
 	void RegisterCallbacks(
 	    Callback_t *readDone,
 	    Callback_t *writeDone,
@@ -81,6 +82,8 @@ public:
 	unsigned systemID;
 
 private:
+	void createController();
+	void deleteController();
 	CSVWriter &csvOut;
 };
 }
@@ -371,6 +371,16 @@ void MultiChannelMemorySystem::update()
 {
 	clockDomainCrosser.update(); 
 }
+void MultiChannelMemorySystem::reset()
+{
+	for (size_t i=0; i<NUM_CHANS; i++)
+	{
+		channels[i]->reset();
+	}
+	// the log files stay open, only the channel timing and the clock crossing restart
+	clockDomainCrosser.counter1 = 0;
+	clockDomainCrosser.counter2 = 0;
+}
 void MultiChannelMemorySystem::actual_update() 
 {
 	if (currentClockCycle == 0)
@@ -6,8 +6,61 @@
 
 namespace base {
 
+    /**
+     * Allocator for buffers aligned to cache lines
+     * @tparam T Data type of the buffer
+     * @tparam ALIGNMENT Alignment in bytes
+     */
+    template <typename T, size_t ALIGNMENT = 64>
+    class AlignedAllocator {
+
+    public:
+
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind {
+            typedef AlignedAllocator<U, ALIGNMENT> other;
+        };
+
+        /** Constructor */
+        AlignedAllocator() = default;
+
+        /** Constructor from the allocator of another type */
+        template <typename U>
+        explicit AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &other) {}
+
+        /** Allocate memory for the values
+         * @param n     Number of values
+         * @return      Aligned pointer to the memory
+         */
+        T *allocate(size_t n) {
+            void *ptr = nullptr;
+            if (posix_memalign(&ptr, ALIGNMENT, std::max(n * sizeof(T), ALIGNMENT)) != 0)
+                throw std::bad_alloc();
+            return static_cast<T*>(ptr);
+        }
+
+        /** Free the memory of the values
+         * @param ptr   Pointer to the memory
+         * @param n     Number of values
+         */
+        void deallocate(T *ptr, size_t /*n*/) {
+            free(ptr);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, ALIGNMENT> &other) const { return true; }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, ALIGNMENT> &other) const { return false; }
+
+    };
+
     /**
      * Numpy style array for the traces
+     * The values are stored in one aligned buffer in row-major order. Copies, samples and zero padded arrays are views
+     * that share the buffer, and only copy the values when they are modified.
      * @tparam T Data type of the array
      */
     template <typename T>
@@ -15,9 +68,9 @@ namespace base {
 
     private:
 
-        typedef std::vector<std::vector<std::vector<std::vector<T>>>> Array4D;
-        typedef std::vector<std::vector<std::vector<T>>> Array3D;
-        typedef std::vector<std::vector<T>> Array2D;
+        template <typename> friend class Array;
+
+        typedef std::vector<T, AlignedAllocator<T>> Buffer;
         typedef std::vector<T> Array1D;
 
         /** Indicates if the values are signed or unsigned */
@@ -31,41 +84,54 @@ namespace base {
          */
         std::vector<size_t> shape;
 
-        /** Vector containing the data if 1 Dimension */
-        Array1D data1D;
+        /** Distance in the buffer between consecutive indices of each dimension */
+        std::vector<size_t> strides;
 
-        /** Vector containing the data if 2 Dimensions */
-        Array2D data2D;
+        /** True if some values are zeros outside of the buffer */
+        bool padded = false;
 
-        /** Vector containing the data if 3 Dimensions */
-        Array3D data3D;
+        /** Zeros before the stored values of each dimension */
+        std::vector<size_t> padding;
 
-        /** Vector containing the data if 4 Dimensions */
-        Array4D data4D;
+        /** Number of stored values of each dimension */
+        std::vector<size_t> extent;
 
-    public:
+        /** Buffer containing the values, shared by all the views */
+        std::shared_ptr<Buffer> data;
 
-        /** Constructor */
-        Array() = default;
+        /** First value of the array in the buffer */
+        T *values = nullptr;
 
-        /** Constructor
-         * @param _data     Vector containing the data
+        /** Set the shape of the array, the strides of a contiguous buffer for it, and no padding
          * @param _shape    Shape of the data
          */
-        Array(const Array2D &_data, const std::vector<size_t> &_shape) {
-            this->data2D = _data;
-            this->shape = _shape;
-        }
+        void set_shape(const std::vector<size_t> &_shape);
 
-        /** Constructor
-         * @param _data     Vector containing the data
+        /** Allocate a new contiguous buffer for the array
          * @param _shape    Shape of the data
          */
-        Array(const Array4D &_data, const std::vector<size_t> &_shape) {
-            this->data4D = _data;
-            this->shape = _shape;
+        void allocate(const std::vector<size_t> &_shape);
+
+        /** Return the value of a zero padded array given the fourth dimensions
+         * @param i     Index for the first dimension
+         * @param j     Index for the second dimension
+         * @param k     Index for the third dimension
+         * @param l     Index for the fourth dimension
+         * @return      Zero if the value is in the padding
+         */
+        T get_padded(size_t i, size_t j, size_t k, size_t l) const {
+            j -= this->padding[1];
+            k -= this->padding[2];
+            l -= this->padding[3];
+            if (j >= this->extent[1] || k >= this->extent[2] || l >= this->extent[3]) return 0;
+            return this->values[i * this->strides[0] + j * this->strides[1] + k * this->strides[2] + l];
         }
 
+    public:
+
+        /** Constructor */
+        Array() = default;
+
         bool isSigned() const;
 
         /** Read the numpy array from the npy file, copy the direction, and set the size
@@ -88,7 +154,14 @@ namespace base {
          *
          * @return      return the value given by the index
          */
-        T get(int i, int j, int k, int l) const;
+        T get(int i, int j, int k, int l) const {
+            #ifdef DEBUG
+            if(getDimensions() != 4)
+                throw std::runtime_error("4D Array dimensions error");
+            #endif
+            if (this->padded) return get_padded(i, j, k, l);
+            return this->values[i * this->strides[0] + j * this->strides[1] + k * this->strides[2] + l];
+        }
 
         /** Return the value inside the vector given the fourth dimensions
          * @param i     Index for the first dimension
@@ -97,7 +170,13 @@ namespace base {
          *
          * @return      return the value given by the index
          */
-        T get(int i, int j, int k) const;
+        T get(int i, int j, int k) const {
+            #ifdef DEBUG
+            if(getDimensions() != 3)
+                throw std::runtime_error("3D Array dimensions error");
+            #endif
+            return this->values[i * this->strides[0] + j * this->strides[1] + k];
+        }
 
         /** Return the value inside the vector given the two dimensions
          * @param i     Index for the first dimension
@@ -105,14 +184,49 @@ namespace base {
          *
          * @return      return the value given by the index
          */
-        T get(int i, int j) const;
+        T get(int i, int j) const {
+            #ifdef DEBUG
+            if(getDimensions() != 2)
+                throw std::runtime_error("2D Array dimensions error");
+            #endif
+            return this->values[i * this->strides[0] + j];
+        }
 
         /** Return the value inside the vector given one dimension
-         * @param index Index for the array
+         * @param index Index for the array, only for arrays without padding
          *
          * @return      return the value given by the index
          */
-        T get(unsigned long long index) const;
+        T get(unsigned long long index) const {
+            return this->values[index];
+        }
+
+        /** Return the buffer with the values without any check, for inner loops
+         * The value (i,j,k,l) is at i * strides[0] + j * strides[1] + k * strides[2] + l
+         * Zero padded arrays must be materialized first.
+         * @return      Pointer to the first value
+         */
+        const T *getData() const {
+            #ifdef DEBUG
+            if(this->padded)
+                throw std::runtime_error("Zero padded array without buffer");
+            #endif
+            return this->values;
+        }
+
+        /** Get the distance in the buffer between consecutive indices of each dimension
+         */
+        const std::vector<size_t> &getStrides() const {
+            return this->strides;
+        }
+
+        /** Check if the array is a view of a buffer shared with other arrays or with padding
+         * @return True if the values must be copied before they are modified
+         */
+        bool isView() const;
+
+        /** Copy the values of the view into its own contiguous buffer, zero padding included */
+        void materialize();
 
         /** Return the number of dimensions of the array
          * @return  Number of dimensions of the array
@@ -124,40 +238,43 @@ namespace base {
         const std::vector<size_t> &getShape() const;
 
         /** Return a fixed point array from already quantised floating-point
+         * @param threads   Number of threads to split the tensor
          * @return Fixed point quantized tensor
          */
-        Array<uint16_t> float_to_int() const;
+        Array<uint16_t> float_to_int(int threads) const;
 
         /** Return a fixed point array given profiled precisions
-         * @param mag   Magnitude (without sign bit)
-         * @param frac  Fraction
+         * @param mag       Magnitude (without sign bit)
+         * @param frac      Fraction
+         * @param threads   Number of threads to split the tensor
          * @return Fixed point quantized tensor
          */
-        Array<uint16_t> profiled_quantization(int mag, int frac) const;
+        Array<uint16_t> profiled_quantization(int mag, int frac, int threads) const;
 
         /**
          * Return a fixed point array for linear quantization
-         * @param data_width Network bits
+         * @param data_width    Network bits
+         * @param threads       Number of threads to split the tensor
          * @return Fixed point quantized tensor
          */
-        Array<uint16_t> linear_quantization(int data_width) const;
+        Array<uint16_t> linear_quantization(int data_width, int threads) const;
 
         /** Change fixed point representation to powers of two
          */
         void powers_of_two_representation();
 
-        /** zero pad the activations
+        /** zero pad the activations, without copying the values
          * @param padding   Padding of the layer
          */
         void zero_pad(int padding);
 
-        /** zero pad the activations to fit on the grid size
+        /** zero pad the activations to fit on the grid size, without copying the values
          * @param X   New X dimension for the activations
          * @param Y   New Y dimension for the activations
          */
         void grid_zero_pad(uint64_t X, uint64_t Y);
 
-        /** zero pad the channel
+        /** zero pad the channel, without copying the values
          * @param K   New K dimension for the channels
          */
         void channel_zero_pad(int K);
@@ -186,7 +303,7 @@ namespace base {
         void reshape_first_layer_wgt(uint16_t stride);
 
         /**
-         * Keep only one sample
+         * Keep only one sample, without copying the values
          * @param sample Sample index to get
          */
         void get_sample(uint64_t sample);
@@ -30,6 +30,9 @@ namespace base {
         /** Numpy activations epoch to read from */
         uint32_t epoch;
 
+        /** Max number of numpy files read concurrently */
+        const uint8_t N_THREADS;
+
         /** Avoid std::out messages */
         const bool QUIET;
 
@@ -45,10 +48,11 @@ namespace base {
          * @param _name     The name of the network
          * @param _batch    Numpy batch of the activations
          * @param _epoch    Numpy epoch of the training traces
+         * @param _N_THREADS Max number of numpy files read concurrently
          * @param _QUIET    Remove stdout messages
          */
-        NetReader(const std::string &_name, uint32_t _batch, uint32_t _epoch, bool _QUIET) : batch(_batch),
-                epoch(_epoch), QUIET(_QUIET) {
+        NetReader(const std::string &_name, uint32_t _batch, uint32_t _epoch, uint8_t _N_THREADS, bool _QUIET) :
+                batch(_batch), epoch(_epoch), N_THREADS(_N_THREADS), QUIET(_QUIET) {
             this->name = _name;
         }
 
@@ -64,11 +68,13 @@ namespace base {
         base::Network<T> read_network_csv();
 
         /** Read the weights into given network
+         * The files of the layers are loaded concurrently by up to N_THREADS threads
          * @param network       Network with the layers already initialized
          */
         void read_weights_npy(base::Network<T> &network);
 
         /** Read the activations into given network
+         * The files of the layers are loaded concurrently by up to N_THREADS threads
          * @param network       Network with the layers already initialized
          */
         void read_activations_npy(base::Network<T> &network);
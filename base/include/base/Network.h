@@ -131,9 +131,10 @@ namespace base {
         void setQuantised(bool _quantised) { Network::quantised = _quantised; }
 
         /** Return a network in fixed point given a floating point network
+         * @param threads   Number of threads to split the tensors of every layer
          * @return   Network in fixed point
          */
-        Network<uint16_t> fixed_point() {
+        Network<uint16_t> fixed_point(int threads) {
             auto fixed_network = Network<uint16_t>(name, quantised, data_width, profiled);
 
             for(auto &layer : layers) {
@@ -141,16 +142,16 @@ namespace base {
                         layer.getPadding(), layer.getActPrecision(), layer.getActMagnitude(), layer.getActFraction(),
                         layer.getWgtPrecision(), layer.getWgtMagnitude(), layer.getWgtFraction());
 
-                if (quantised) fixed_layer.setActivations(layer.getActivations().float_to_int());
+                if (quantised) fixed_layer.setActivations(layer.getActivations().float_to_int(threads));
                 else if (profiled) fixed_layer.setActivations(layer.getActivations().profiled_quantization
-                        (layer.getActMagnitude(), layer.getActFraction()));
-                else fixed_layer.setActivations(layer.getActivations().linear_quantization(data_width));
+                        (layer.getActMagnitude(), layer.getActFraction(), threads));
+                else fixed_layer.setActivations(layer.getActivations().linear_quantization(data_width, threads));
                 layer.setActivations(Array<T>()); // Clear
 
-                if (quantised) fixed_layer.setWeights(layer.getWeights().float_to_int());
+                if (quantised) fixed_layer.setWeights(layer.getWeights().float_to_int(threads));
                 else if (profiled) fixed_layer.setWeights(layer.getWeights().profiled_quantization
-                        (layer.getWgtMagnitude(), layer.getWgtFraction()));
-                else fixed_layer.setWeights(layer.getWeights().linear_quantization(data_width));
+                        (layer.getWgtMagnitude(), layer.getWgtFraction(), threads));
+                else fixed_layer.setWeights(layer.getWeights().linear_quantization(data_width, threads));
                 layer.setWeights(Array<T>()); // Clear
 
                 fixed_network.updateLayers().emplace_back(fixed_layer);
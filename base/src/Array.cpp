@@ -8,200 +8,84 @@ namespace base {
         return signed_data;
     }
 
-    /* SETTERS */
-
     template <typename T>
-    void Array<T>::set_values(const std::string &path) {
-        base::NpyArray data_npy;
-        base::npy_load(path, data_npy, this->shape);
-        std::vector<T> flat_array = data_npy.as_vec<T>();
-        auto min_value = *std::min_element(flat_array.begin(), flat_array.end());
-        signed_data = min_value < 0;
-        if (this->getDimensions() == 1) this->data1D = flat_array;
-        else if(this->getDimensions() == 2){
-            this->data2D = Array2D(this->shape[0],Array1D(this->shape[1]));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++)
-                    this->data2D[i][j] = flat_array[this->shape[1]*i + j];
-            }
-
-        } else if (this->getDimensions() == 3) {
-            unsigned long coef1 = shape[1]*shape[2];
-            this->data3D = Array3D(this->shape[0],Array2D(this->shape[1],Array1D(this->shape[2])));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++)
-                        this->data3D[i][j][k] = flat_array[coef1*i + shape[2]*j + k];
-                }
-            }
-        } else if (this->getDimensions() == 4) {
-            unsigned long coef1 = shape[1]*shape[2]*shape[3];
-            unsigned long coef2 = shape[2]*shape[3];
-            this->data4D = Array4D(this->shape[0],Array3D(this->shape[1],Array2D(this->shape[2],
-                    Array1D(this->shape[3]))));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        for(int l = 0; l < this->shape[3]; l++)
-                            this->data4D[i][j][k][l] = flat_array[coef1*i + coef2*j + shape[3]*k + l];
-                    }
-                }
-            }
-        } else throw std::runtime_error("Array dimensions error");
+    void Array<T>::set_shape(const std::vector<size_t> &_shape) {
+        this->shape = _shape;
+        this->strides = std::vector<size_t>(_shape.size(), 1);
+        for (int d = (int)_shape.size() - 2; d >= 0; d--)
+            this->strides[d] = this->strides[d + 1] * _shape[d + 1];
+        this->padded = false;
+        this->padding = std::vector<size_t>(_shape.size(), 0);
+        this->extent = _shape;
     }
 
     template <typename T>
-    void Array<T>::set_values(const std::vector<T> &_data, const std::vector<size_t> &_shape, bool _signed_data) {
-        Array::signed_data = _signed_data;
-        Array::shape = _shape;
-        if (this->getDimensions() == 1) this->data1D = _data;
-        else if(this->getDimensions() == 2){
-            this->data2D = Array2D(this->shape[0],Array1D(this->shape[1]));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++)
-                    this->data2D[i][j] = _data[this->shape[1]*i + j];
-            }
-        } else if (this->getDimensions() == 3) {
-            unsigned long coef1 = shape[1]*shape[2];
-            this->data3D = Array3D(this->shape[0],Array2D(this->shape[1],Array1D(this->shape[2])));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++)
-                        this->data3D[i][j][k] = _data[coef1*i + shape[2]*j + k];
-                }
-            }
-        } else if (this->getDimensions() == 4) {
-            auto coef1 = shape[1]*shape[2]*shape[3];
-            auto coef2 = shape[2]*shape[3];
-            this->data4D = Array4D(this->shape[0],Array3D(this->shape[1],Array2D(this->shape[2],
-                    Array1D(this->shape[3]))));
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        for(int l = 0; l < this->shape[3]; l++)
-                            this->data4D[i][j][k][l] = _data[coef1*i + coef2*j + shape[3]*k + l];
-                    }
-                }
-            }
-        } else throw std::runtime_error("Array dimensions error");
+    void Array<T>::allocate(const std::vector<size_t> &_shape) {
+        this->set_shape(_shape);
+        this->data = std::make_shared<Buffer>(_shape[0] * this->strides[0], 0);
+        this->values = this->data->data();
     }
 
-    /* GETTERS */
-
     template <typename T>
-    T Array<T>::get (int i, int j, int k, int l) const {
-        #ifdef DEBUG
-        if(getDimensions() != 4)
-            throw std::runtime_error("4D Array dimensions error");
-        #endif
-        return this->data4D[i][j][k][l];
+    bool Array<T>::isView() const {
+        return this->padded || this->data.use_count() > 1;
     }
 
     template <typename T>
-    T Array<T>::get (int i, int j, int k) const {
-        #ifdef DEBUG
-        if(getDimensions() != 3)
-            throw std::runtime_error("3D Array dimensions error");
-        #endif
-        return this->data3D[i][j][k];
-    }
-
-    template <typename T>
-    T Array<T>::get (int i, int j) const {
-        #ifdef DEBUG
-        if(getDimensions() != 2)
-            throw std::runtime_error("2D Array dimensions error");
-        #endif
-        return this->data2D[i][j];
-    }
-
-    template <typename T>
-    T max_1D(const std::vector<T> &vector) {
-        return *std::max_element(vector.begin(), vector.end());
-    }
-
-    template <typename T>
-    T max_2D(const std::vector<std::vector<T>> &vector) {
-        std::vector<T> maximums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            maximums[i] = max_1D(vector[i]);
-        }
-        return max_1D(maximums);
-    }
-
-    template <typename T>
-    T max_3D(const std::vector<std::vector<std::vector<T>>> &vector) {
-        std::vector<T> maximums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            maximums[i] = max_2D(vector[i]);
-        }
-        return max_1D(maximums);
-    }
-
-    template <typename T>
-    T max_4D(const std::vector<std::vector<std::vector<std::vector<T>>>> &vector) {
-        std::vector<T> maximums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            maximums[i] = max_3D(vector[i]);
+    void Array<T>::materialize() {
+        if (!this->isView()) return;
+
+        Array<T> dense;
+        dense.allocate(this->shape);
+
+        if (this->padded) {
+            // Copy the rows of stored values, the padding is already zero
+            for (int n = 0; n < this->extent[0]; n++) {
+                for (int k = 0; k < this->extent[1]; k++) {
+                    for (int i = 0; i < this->extent[2]; i++) {
+                        const T *row = &this->values[n * this->strides[0] + k * this->strides[1] +
+                                i * this->strides[2]];
+                        std::copy(row, row + this->extent[3], &dense.values[n * dense.strides[0] +
+                                (this->padding[1] + k) * dense.strides[1] + (this->padding[2] + i) * dense.strides[2] +
+                                this->padding[3]]);
+                    }
+                }
+            }
+        } else {
+            std::copy(this->values, this->values + this->shape[0] * this->strides[0], dense.values);
         }
-        return max_1D(maximums);
-    }
 
-    template <typename T>
-    T min_1D(const std::vector<T> &vector) {
-        return *std::min_element(vector.begin(), vector.end());
+        this->data = std::move(dense.data);
+        this->values = dense.values;
+        this->set_shape(dense.shape);
     }
 
-    template <typename T>
-    T min_2D(const std::vector<std::vector<T>> &vector) {
-        std::vector<T> minimums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            minimums[i] = min_1D(vector[i]);
-        }
-        return min_1D(minimums);
-    }
+    /* SETTERS */
 
     template <typename T>
-    T min_3D(const std::vector<std::vector<std::vector<T>>> &vector) {
-        std::vector<T> minimums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            minimums[i] = min_2D(vector[i]);
-        }
-        return min_1D(minimums);
+    void Array<T>::set_values(const std::string &path) {
+        base::NpyArray data_npy;
+        std::vector<size_t> _shape;
+        base::npy_load(path, data_npy, _shape);
+        if (_shape.empty() || _shape.size() > 4) throw std::runtime_error("Array dimensions error");
+        this->set_shape(_shape);
+        const T *npy_values = data_npy.data<T>();
+        this->data = std::make_shared<Buffer>(npy_values, npy_values + data_npy.num_vals);
+        this->values = this->data->data();
+        auto min_value = *std::min_element(this->data->begin(), this->data->end());
+        signed_data = min_value < 0;
     }
 
     template <typename T>
-    T min_4D(const std::vector<std::vector<std::vector<std::vector<T>>>> &vector) {
-        std::vector<T> minimums = std::vector<T>(vector.size(),0);
-        for(int i = 0; i < vector.size(); i++) {
-            minimums[i] = min_3D(vector[i]);
-        }
-        return min_1D(minimums);
+    void Array<T>::set_values(const std::vector<T> &_data, const std::vector<size_t> &_shape, bool _signed_data) {
+        if (_shape.empty() || _shape.size() > 4) throw std::runtime_error("Array dimensions error");
+        Array::signed_data = _signed_data;
+        this->set_shape(_shape);
+        this->data = std::make_shared<Buffer>(_data.begin(), _data.end());
+        this->values = this->data->data();
     }
 
-    template <typename T>
-    T Array<T>::get(unsigned long long index) const {
-        if(this->getDimensions() == 4) {
-            auto i = index / (this->shape[1]*this->shape[2]*this->shape[3]);
-            auto rem = index % (this->shape[1]*this->shape[2]*this->shape[3]);
-            auto j = rem / (this->shape[2]*this->shape[3]);
-            rem %= (this->shape[2]*this->shape[3]);
-            auto k = rem / this->shape[3];
-            auto l = rem % this->shape[3];
-            return this->data4D[i][j][k][l];
-        } else if(this->getDimensions() == 3) {
-            auto i = index / (this->shape[1]*this->shape[2]);
-            auto rem = index % (this->shape[1]*this->shape[2]);
-            auto j = rem / this->shape[2];
-            auto k = rem % this->shape[2];
-            return this->data3D[i][j][k];
-        } else if (this->getDimensions() == 2) {
-            auto i = index / this->shape[1];
-            auto j = index % this->shape[1];
-            return this->data2D[i][j];
-        } else if (this->getDimensions() == 1) return this->data1D[index];
-        else throw std::runtime_error("Array dimensions error");
-    }
+    /* GETTERS */
 
     template <typename T>
     unsigned long Array<T>::getDimensions() const {
@@ -217,54 +101,31 @@ namespace base {
 
     /* DATA TRANSFORMATION */
 
+    /** Tensors smaller than this are converted in a single thread */
+    static const uint64_t MIN_PARALLEL_SIZE = 1u << 16u;
+
     template <typename T>
-    Array<uint16_t> Array<T>::float_to_int() const {
-        std::vector<uint16_t> fixed_point_vector;
-        if (this->getDimensions() == 1) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                auto float_value = this->data1D[i];
-                fixed_point_vector.push_back((int)float_value);
-            }
-        } else if(this->getDimensions() == 2){
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    auto float_value = this->data2D[i][j];
-                    fixed_point_vector.push_back((int)float_value);
-                }
-            }
-        } else if (this->getDimensions() == 3) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        auto float_value = this->data3D[i][j][k];
-                        fixed_point_vector.push_back((int)float_value);
-                    }
-                }
-            }
-        } else if (this->getDimensions() == 4) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        for(int l = 0; l < this->shape[3]; l++) {
-                            auto float_value = this->data4D[i][j][k][l];
-                            fixed_point_vector.push_back((int)float_value);
-                        }
-                    }
-                }
-            }
-        } else throw std::runtime_error("Array dimensions error");
+    Array<uint16_t> Array<T>::float_to_int(int threads) const {
+        Array<T> dense = *this;
+        if (dense.padded) dense.materialize();
+        const T *flat_array = dense.values;
+        uint64_t size = dense.shape[0] * dense.strides[0];
 
         Array<uint16_t> fixed_point_array;
-        fixed_point_array.set_values(fixed_point_vector, this->shape, this->signed_data);
+        fixed_point_array.signed_data = this->signed_data;
+        fixed_point_array.allocate(this->shape);
+        uint16_t *fixed_point_vector = fixed_point_array.values;
+
+        #pragma omp parallel for simd num_threads(threads) if(size >= MIN_PARALLEL_SIZE)
+        for(uint64_t i = 0; i < size; i++)
+            fixed_point_vector[i] = (int)flat_array[i];
+
         return fixed_point_array;
     }
 
     /* Return value in two complement */
     static inline
-    uint16_t profiled_value(float num, int mag, int frac) {
-        double scale = pow(2.,(double)frac);
-        double intmax = (1u << (mag + frac)) - 1;
-        double intmin = -1 * intmax;
+    uint16_t profiled_value(float num, double scale, double intmax, double intmin) {
         double ds = num * scale;
         if (ds > intmax) ds = intmax;
         if (ds < intmin) ds = intmin;
@@ -273,44 +134,25 @@ namespace base {
     }
 
     template <typename T>
-    Array<uint16_t> Array<T>::profiled_quantization(int mag, int frac) const {
-        std::vector<uint16_t> fixed_point_vector;
-        if (this->getDimensions() == 1) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                auto float_value = this->data1D[i];
-                fixed_point_vector.push_back(profiled_value(float_value,mag,frac));
-            }
-        } else if(this->getDimensions() == 2){
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    auto float_value = this->data2D[i][j];
-                    fixed_point_vector.push_back(profiled_value(float_value,mag,frac));
-                }
-            }
-        } else if (this->getDimensions() == 3) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        auto float_value = this->data3D[i][j][k];
-                        fixed_point_vector.push_back(profiled_value(float_value,mag,frac));
-                    }
-                }
-            }
-        } else if (this->getDimensions() == 4) {
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        for(int l = 0; l < this->shape[3]; l++) {
-                            auto float_value = this->data4D[i][j][k][l];
-                            fixed_point_vector.push_back(profiled_value(float_value,mag,frac));
-                        }
-                    }
-                }
-            }
-        } else throw std::runtime_error("Array dimensions error");
+    Array<uint16_t> Array<T>::profiled_quantization(int mag, int frac, int threads) const {
+        Array<T> dense = *this;
+        if (dense.padded) dense.materialize();
+        const T *flat_array = dense.values;
+        uint64_t size = dense.shape[0] * dense.strides[0];
 
         Array<uint16_t> fixed_point_array;
-        fixed_point_array.set_values(fixed_point_vector, this->shape, this->signed_data);
+        fixed_point_array.signed_data = this->signed_data;
+        fixed_point_array.allocate(this->shape);
+        uint16_t *fixed_point_vector = fixed_point_array.values;
+
+        double scale = pow(2.,(double)frac);
+        double intmax = (1u << (mag + frac)) - 1;
+        double intmin = -1 * intmax;
+
+        #pragma omp parallel for simd num_threads(threads) if(size >= MIN_PARALLEL_SIZE)
+        for(uint64_t i = 0; i < size; i++)
+            fixed_point_vector[i] = profiled_value(flat_array[i], scale, intmax, intmin);
+
         return fixed_point_array;
     }
 
@@ -319,272 +161,100 @@ namespace base {
         auto two_comp = (int)round(num * scale);
         two_comp = std::max(two_comp, min_fixed);
         two_comp = std::min(two_comp, max_fixed);
-    return (uint16_t)two_comp;
-}
+        return (uint16_t)two_comp;
+    }
 
     template <typename T>
-    Array<uint16_t> Array<T>::linear_quantization(int data_width) const {
+    Array<uint16_t> Array<T>::linear_quantization(int data_width, int threads) const {
         int max_fixed = (int)pow(2, data_width - 1) - 1;
         int min_fixed = (int)(pow(2, data_width - 1) - 1) * -1 - 1;
 
-        std::vector<uint16_t> fixed_point_vector;
-        if (this->getDimensions() == 1) {
-
-            auto min_value = min_1D(this->data1D);
-            auto max_value = max_1D(this->data1D);
-            auto m = std::max(fabsf(max_value), fabsf(min_value));
-            float scale;
-            if (min_value == 0) {
-                min_fixed = 0;
-                max_fixed = (int)pow(2, data_width) - 1;
-                scale = (max_fixed - min_fixed) / m;
-            } else {
-                scale = (max_fixed - min_fixed) / (2 * m);
-            }
-
-            for(int i = 0; i < this->shape[0]; i++) {
-                auto float_value = this->data1D[i];
-                fixed_point_vector.push_back(linear_value(float_value,scale,max_fixed,min_fixed));
-            }
-        } else if(this->getDimensions() == 2){
-
-            auto min_value = min_2D(this->data2D);
-            auto max_value = max_2D(this->data2D);
-            auto m = std::max(fabsf(max_value), fabsf(min_value));
-            float scale;
-            if (min_value == 0) {
-                min_fixed = 0;
-                max_fixed = (int)pow(2, data_width) - 1;
-                scale = (max_fixed - min_fixed) / m;
-            } else {
-                scale = (max_fixed - min_fixed) / (2 * m);
-            }
+        Array<T> dense = *this;
+        if (dense.padded) dense.materialize();
+        const T *flat_array = dense.values;
+        uint64_t size = dense.shape[0] * dense.strides[0];
 
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    auto float_value = this->data2D[i][j];
-                    fixed_point_vector.push_back(linear_value(float_value,scale,max_fixed,min_fixed));
-                }
-            }
-        } else if (this->getDimensions() == 3) {
-
-            auto min_value = min_3D(this->data3D);
-            auto max_value = max_3D(this->data3D);
-            auto m = std::max(fabsf(max_value), fabsf(min_value));
-            float scale;
-            if (min_value == 0) {
-                min_fixed = 0;
-                max_fixed = 255;
-                max_fixed = (int)pow(2, data_width) - 1;
-            } else {
-                scale = (max_fixed - min_fixed) / (2 * m);
-            }
+        Array<uint16_t> fixed_point_array;
+        fixed_point_array.signed_data = this->signed_data;
+        fixed_point_array.allocate(this->shape);
+        uint16_t *fixed_point_vector = fixed_point_array.values;
+
+        T min_value = size == 0 ? 0 : flat_array[0];
+        T max_value = min_value;
+        #pragma omp parallel for simd num_threads(threads) if(size >= MIN_PARALLEL_SIZE) \
+                reduction(min:min_value) reduction(max:max_value)
+        for(uint64_t i = 0; i < size; i++) {
+            min_value = std::min(min_value, flat_array[i]);
+            max_value = std::max(max_value, flat_array[i]);
+        }
 
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        auto float_value = this->data3D[i][j][k];
-                        fixed_point_vector.push_back(linear_value(float_value,scale,max_fixed,min_fixed));
-                    }
-                }
-            }
-        } else if (this->getDimensions() == 4) {
-
-            auto min_value = min_4D(this->data4D);
-            auto max_value = max_4D(this->data4D);
-            auto m = std::max(fabsf(max_value), fabsf(min_value));
-            float scale;
-            if (min_value == 0) {
-                min_fixed = 0;
-                max_fixed = (int)pow(2, data_width) - 1;
-                scale = (max_fixed - min_fixed) / m;
-            } else {
-                scale = (max_fixed - min_fixed) / (2 * m);
-            }
+        auto m = std::max(fabsf(max_value), fabsf(min_value));
+        float scale;
+        if (min_value == 0) {
+            min_fixed = 0;
+            max_fixed = (int)pow(2, data_width) - 1;
+            scale = (max_fixed - min_fixed) / m;
+        } else {
+            scale = (max_fixed - min_fixed) / (2 * m);
+        }
 
-            for(int i = 0; i < this->shape[0]; i++) {
-                for(int j = 0; j < this->shape[1]; j++) {
-                    for(int k = 0; k < this->shape[2]; k++) {
-                        for(int l = 0; l < this->shape[3]; l++) {
-                            auto float_value = this->data4D[i][j][k][l];
-                            fixed_point_vector.push_back(linear_value(float_value,scale,max_fixed,min_fixed));
-                        }
-                    }
-                }
-            }
-        } else throw std::runtime_error("Array dimensions error");
+        #pragma omp parallel for simd num_threads(threads) if(size >= MIN_PARALLEL_SIZE)
+        for(uint64_t i = 0; i < size; i++)
+            fixed_point_vector[i] = linear_value(flat_array[i], scale, max_fixed, min_fixed);
 
-        Array<uint16_t> fixed_point_array;
-        fixed_point_array.set_values(fixed_point_vector, this->shape, this->signed_data);
         return fixed_point_array;
     }
 
     template <typename T>
     void Array<T>::powers_of_two_representation() {
-    if (this->getDimensions() == 1) {
-        for(int i = 0; i < this->shape[0]; i++) {
-            auto two_comp = (short)this->data1D[i];
-            auto powers_of_two = (uint16_t)abs(two_comp);
-            this->data1D[i] = powers_of_two;
-        }
-    } else if(this->getDimensions() == 2){
-        for(int i = 0; i < this->shape[0]; i++) {
-            for(int j = 0; j < this->shape[1]; j++) {
-                auto two_comp = (short)this->data2D[i][j];
-                auto powers_of_two = (uint16_t)abs(two_comp);
-                this->data2D[i][j] = powers_of_two;
-            }
-        }
-    } else if (this->getDimensions() == 3) {
-        for(int i = 0; i < this->shape[0]; i++) {
-            for(int j = 0; j < this->shape[1]; j++) {
-                for(int k = 0; k < this->shape[2]; k++) {
-                    auto two_comp = (short)this->data3D[i][j][k];
-                    auto powers_of_two = (uint16_t)abs(two_comp);
-                    this->data3D[i][j][k] = powers_of_two;
-                }
-            }
-        }
-    } else if (this->getDimensions() == 4) {
-        for(int i = 0; i < this->shape[0]; i++) {
-            for(int j = 0; j < this->shape[1]; j++) {
-                for(int k = 0; k < this->shape[2]; k++) {
-                    for(int l = 0; l < this->shape[3]; l++) {
-                        auto two_comp = (short)this->data4D[i][j][k][l];
-                        auto powers_of_two = (uint16_t)abs(two_comp);
-                        this->data4D[i][j][k][l] = powers_of_two;
-                    }
-                }
-            }
-        }
-    } else throw std::runtime_error("Array dimensions error");
-}
+        this->materialize();
+        T *values = this->values;
+        uint64_t size = this->shape[0] * this->strides[0];
+        #pragma omp simd
+        for(uint64_t i = 0; i < size; i++)
+            values[i] = (uint16_t)abs((short)values[i]);
+    }
 
     /* PADDING */
 
     template <typename T>
     void Array<T>::zero_pad(int padding) {
-        auto batch_size = this->shape[0];
-        auto act_channels = this->shape[1];
-        auto Nx = this->shape[2];
-        auto Ny = this->shape[3];
-
-        auto tmp_data4D = Array4D(batch_size, Array3D(act_channels, Array2D(Nx + 2*padding,Array1D(Ny + 2*padding,0))));
-
-        for(int n = 0; n < batch_size; n++) {
-            for (int k = 0; k < act_channels; k++) {
-                for (int i = 0; i < Nx; i++) {
-                    for(int j = 0; j < Ny; j++) {
-                        tmp_data4D[n][k][padding + i][padding + j] = this->data4D[n][k][i][j];
-                    }
-                }
-            }
-        }
-
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(batch_size);
-        this->shape.push_back(act_channels);
-        this->shape.push_back(Nx + 2*padding);
-        this->shape.push_back(Ny + 2*padding);
+        if (padding <= 0) return;
+        this->padding[2] += padding;
+        this->padding[3] += padding;
+        this->shape[2] += 2 * padding;
+        this->shape[3] += 2 * padding;
+        this->padded = true;
     }
 
     template <typename T>
     void Array<T>::grid_zero_pad(uint64_t X, uint64_t Y) {
-        auto batch_size = this->shape[0];
-        auto act_channels = this->shape[1];
-        auto Nx = this->shape[2];
-        auto Ny = this->shape[3];
-
-        auto tmp_data4D = Array4D(batch_size, Array3D(act_channels, Array2D(X, Array1D(Y,0))));
-
-        for(int n = 0; n < batch_size; n++) {
-            for (int k = 0; k < act_channels; k++) {
-                for (int i = 0; i < Nx; i++) {
-                    for(int j = 0; j < Ny; j++) {
-                        tmp_data4D[n][k][i][j] = this->data4D[n][k][i][j];
-                    }
-                }
-            }
-        }
-
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(batch_size);
-        this->shape.push_back(act_channels);
-        this->shape.push_back((unsigned)X);
-        this->shape.push_back((unsigned)Y);
+        if (X == this->shape[2] && Y == this->shape[3]) return;
+        this->shape[2] = X;
+        this->shape[3] = Y;
+        this->padded = true;
     }
 
     template <typename T>
     void Array<T>::channel_zero_pad(int K) {
-        auto N = this->shape[0];
-        auto old_k = this->shape[1];
-        auto X = this->shape[2];
-        auto Y = this->shape[3];
-
-
-        auto tmp_data4D = Array4D(N, Array3D(K, Array2D(X, Array1D(Y, 0))));
-
-        for(int n = 0; n < N; n++) {
-            for (int k = 0; k < old_k; k++) {
-                for (int i = 0; i < X; i++) {
-                    for(int j = 0; j < Y; j++) {
-                        tmp_data4D[n][k][i][j] = this->data4D[n][k][i][j];
-                    }
-                }
-            }
-        }
-
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(N);
-        this->shape.push_back((unsigned)K);
-        this->shape.push_back(X);
-        this->shape.push_back(Y);
+        if (K == this->shape[1]) return;
+        this->shape[1] = K;
+        this->padded = true;
     }
 
     /* RESHAPE */
 
     template <typename T>
     void Array<T>::reshape_to_4D() {
-        this->data4D.clear();
-        this->data4D = Array4D(this->shape[0],Array3D(this->shape[1],Array2D(1,Array1D(1))));
-        for(int i = 0; i < this->shape[0]; i++) {
-            for(int j = 0; j < this->shape[1]; j++) {
-                this->data4D[i][j][0][0] = this->data2D[i][j];
-            }
-        }
-        this->data2D.clear();
-        this->shape.clear();
-        this->shape.push_back(this->shape[0]);
-        this->shape.push_back(this->shape[1]);
-        this->shape.push_back(1);
-        this->shape.push_back(1);
+        if (this->padded) this->materialize();
+        this->set_shape({this->shape[0], this->shape[1], 1, 1});
         this->force4D = true;
     }
 
     template <typename T>
     void Array<T>::reshape_to_2D() {
-        this->data2D.clear();
-        for(int i = 0; i < this->shape[0]; i++) {
-            std::vector<T> second_dim;
-            for(int j = 0; j < this->shape[1]; j++) {
-                for(int k = 0; k < this->shape[2]; k++) {
-                    for(int l = 0; l < this->shape[3]; l++) {
-                        second_dim.push_back(this->data4D[i][j][k][l]);
-                    }
-                }
-            }
-            this->data2D.push_back(second_dim);
-        }
-        this->data4D.clear();
-        this->shape[1] = this->shape[1]*this->shape[2]*this->shape[3];
-        this->shape.pop_back();
-        this->shape.pop_back();
+        if (this->padded) this->materialize();
+        this->set_shape({this->shape[0], this->shape[1]*this->shape[2]*this->shape[3]});
     }
 
     template <typename T>
@@ -594,7 +264,8 @@ namespace base {
         auto old_X = this->shape[2];
         auto old_Y = this->shape[3];
 
-        auto tmp_data4D = Array4D(N,Array3D((unsigned)K,Array2D((unsigned)X,Array1D((unsigned)Y,0))));
+        Array<T> split;
+        split.allocate({N, (size_t)K, (size_t)X, (size_t)Y});
 
         for(int n = 0; n < N; n++) {
             for (int k = 0; k < old_k; k++) {
@@ -604,19 +275,16 @@ namespace base {
                         auto rem = k % (X*Y);
                         auto new_i = rem / Y;
                         auto new_j = rem % Y;
-                        tmp_data4D[n][new_k][new_i][new_j] = this->data4D[n][k][i][j];
+                        split.values[n * split.strides[0] + new_k * split.strides[1] + new_i * split.strides[2] +
+                                new_j] = this->get(n, k, i, j);
                     }
                 }
             }
         }
 
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(N);
-        this->shape.push_back((unsigned)K);
-        this->shape.push_back((unsigned)X);
-        this->shape.push_back((unsigned)Y);
+        this->data = std::move(split.data);
+        this->values = split.values;
+        this->set_shape(split.shape);
     }
 
     template <typename T>
@@ -631,7 +299,8 @@ namespace base {
         auto new_Nx = (uint16_t)ceil(Nx/(double)stride);
         auto new_Ny = (uint16_t)ceil(Nx/(double)stride);
 
-        auto tmp_data4D = Array4D(batch_size, Array3D(new_act_channels, Array2D(new_Nx, Array1D(new_Ny, 0))));
+        Array<T> reshaped;
+        reshaped.allocate({batch_size, (size_t)new_act_channels, new_Nx, new_Ny});
 
         for(int n = 0; n < batch_size; n++)
             for(int k = 0; k < act_channels; k++)
@@ -640,16 +309,13 @@ namespace base {
                         auto new_i = i/stride;
                         auto new_j = j/stride;
                         auto new_k = (j%stride)*stride*act_channels + act_channels*(i%stride) + k;
-                        tmp_data4D[n][new_k][new_i][new_j] = this->data4D[n][k][i][j];
+                        reshaped.values[n * reshaped.strides[0] + new_k * reshaped.strides[1] +
+                                new_i * reshaped.strides[2] + new_j] = this->get(n, k, i, j);
                     }
 
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(batch_size);
-        this->shape.push_back(new_act_channels);
-        this->shape.push_back(new_Nx);
-        this->shape.push_back(new_Ny);
+        this->data = std::move(reshaped.data);
+        this->values = reshaped.values;
+        this->set_shape(reshaped.shape);
     }
 
     template <typename T>
@@ -664,7 +330,8 @@ namespace base {
         auto new_Kx = (uint16_t)ceil(Kx/(double)stride);
         auto new_Ky = (uint16_t)ceil(Ky/(double)stride);
 
-        auto tmp_data4D = Array4D(num_filters, Array3D(new_wgt_channels, Array2D(new_Kx, Array1D(new_Ky, 0))));
+        Array<T> reshaped;
+        reshaped.allocate({num_filters, (size_t)new_wgt_channels, new_Kx, new_Ky});
 
         for(int m = 0; m < num_filters; m++)
             for(int k = 0; k < wgt_channels; k++)
@@ -673,65 +340,29 @@ namespace base {
                         auto new_i = i/stride;
                         auto new_j = j/stride;
                         auto new_k = (j%stride)*stride*wgt_channels + wgt_channels*(i%stride) + k;
-                        tmp_data4D[m][new_k][new_i][new_j] = this->data4D[m][k][i][j];
+                        reshaped.values[m * reshaped.strides[0] + new_k * reshaped.strides[1] +
+                                new_i * reshaped.strides[2] + new_j] = this->get(m, k, i, j);
                     }
 
-        this->data4D.clear();
-        this->data4D = tmp_data4D;
-        this->shape.clear();
-        this->shape.push_back(num_filters);
-        this->shape.push_back(new_wgt_channels);
-        this->shape.push_back(new_Kx);
-        this->shape.push_back(new_Ky);
+        this->data = std::move(reshaped.data);
+        this->values = reshaped.values;
+        this->set_shape(reshaped.shape);
     }
 
     template <typename T>
     void Array<T>::get_sample(uint64_t sample) {
 
-        if (this->getDimensions() == 3) { // RNNs
-            auto batch_size = this->shape[0];
-            auto recurrences = this->shape[1];
-            auto act_channels = this->shape[2];
-
-            if (sample > (batch_size - 1))
-                throw std::runtime_error("Sample required is out of the scope");
-
-            auto tmp_data3D = Array3D(1, Array2D(recurrences, Array1D(act_channels, 0)));
-
-            for (int r = 0; r < recurrences; r++) {
-                for (int k = 0; k < act_channels; k++) {
-                    tmp_data3D[0][r][k] = this->data3D[sample][r][k];
-                }
-            }
-
-            this->data3D.clear();
-            this->data3D = tmp_data3D;
-            this->shape[0] = 1;
-
-        } else if (this->getDimensions() == 4) {
-            auto batch_size = this->shape[0];
-            auto act_channels = this->shape[1];
-            auto Nx = this->shape[2];
-            auto Ny = this->shape[3];
+        if (this->getDimensions() != 3 && this->getDimensions() != 4)
+            throw std::runtime_error("Array dimensions error");
 
-            if (sample > (batch_size - 1))
-                throw std::runtime_error("Sample required is out of the scope");
-
-            auto tmp_data4D = Array4D(1, Array3D(act_channels, Array2D(Nx, Array1D(Ny, 0))));
-
-            for (int k = 0; k < act_channels; k++) {
-                for (int i = 0; i < Nx; i++) {
-                    for(int j = 0; j < Ny; j++) {
-                        tmp_data4D[0][k][i][j] = this->data4D[sample][k][i][j];
-                    }
-                }
-            }
-
-            this->data4D.clear();
-            this->data4D = tmp_data4D;
-            this->shape[0] = 1;
+        auto batch_size = this->shape[0];
+        if (sample > (batch_size - 1))
+            throw std::runtime_error("Sample required is out of the scope");
 
-        } else throw std::runtime_error("Array dimensions error");
+        // The sample is a view of the same buffer
+        this->values += sample * this->strides[0];
+        this->shape[0] = 1;
+        this->extent[0] = 1;
     }
 
     INITIALISE_DATA_TYPES(Array);
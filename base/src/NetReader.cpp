@@ -113,12 +113,26 @@ namespace base {
     template <typename T>
     void NetReader<T>::read_weights_npy(base::Network<T> &network) {
         check_path("net_traces/" + this->name);
-        for(base::Layer<T> &layer : network.updateLayers()) {
-            std::string file = "/wgt-" + layer.getName() + ".npy" ;
-            base::Array<T> weights; weights.set_values("net_traces/" + this->name + file);
-            layer.setWeights(weights);
+        auto &layers = network.updateLayers();
+
+        // Errors raised inside the parallel region are rethrown once all the files are read
+        std::exception_ptr error = nullptr;
+
+        #pragma omp parallel for num_threads(N_THREADS) schedule(dynamic)
+        for(int layer_it = 0; layer_it < layers.size(); ++layer_it) {
+            try {
+                base::Layer<T> &layer = layers[layer_it];
+                std::string file = "/wgt-" + layer.getName() + ".npy" ;
+                base::Array<T> weights; weights.set_values("net_traces/" + this->name + file);
+                layer.setWeights(weights);
+            } catch (...) {
+                #pragma omp critical
+                if (error == nullptr) error = std::current_exception();
+            }
         }
 
+        if (error != nullptr) std::rethrow_exception(error);
+
         if(!QUIET) std::cout << "Weight traces loaded from numpy arrays" << std::endl;
 
     }
@@ -126,12 +140,26 @@ namespace base {
     template <typename T>
     void NetReader<T>::read_activations_npy(base::Network<T> &network) {
         check_path("net_traces/" + this->name);
-        for(base::Layer<T> &layer : network.updateLayers()) {
-            std::string file = "/act-" + layer.getName() + "-" + std::to_string(batch) + ".npy";
-            base::Array<T> activations; activations.set_values("net_traces/" + this->name + file);
-            layer.setActivations(activations);
+        auto &layers = network.updateLayers();
+
+        // Errors raised inside the parallel region are rethrown once all the files are read
+        std::exception_ptr error = nullptr;
+
+        #pragma omp parallel for num_threads(N_THREADS) schedule(dynamic)
+        for(int layer_it = 0; layer_it < layers.size(); ++layer_it) {
+            try {
+                base::Layer<T> &layer = layers[layer_it];
+                std::string file = "/act-" + layer.getName() + "-" + std::to_string(batch) + ".npy";
+                base::Array<T> activations; activations.set_values("net_traces/" + this->name + file);
+                layer.setActivations(activations);
+            } catch (...) {
+                #pragma omp critical
+                if (error == nullptr) error = std::current_exception();
+            }
         }
 
+        if (error != nullptr) std::rethrow_exception(error);
+
         if(!QUIET) std::cout << "Activation traces loaded from numpy arrays" << std::endl;
 
     }
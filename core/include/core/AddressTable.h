@@ -0,0 +1,179 @@
+#ifndef DNNSIM_ADDRESSTABLE_H
+#define DNNSIM_ADDRESSTABLE_H
+
+#include "Utils.h"
+
+namespace core {
+
+    /**
+     * On-chip hierarchy level of the tracked addresses
+     * The addresses are blocks of the activation and weight regions, so the levels of every region are stored in a
+     * flat table indexed by block, covering the blocks tracked since the last clear. Addresses outside the regions, or
+     * not aligned to a block, are kept in a map.
+     */
+    class AddressTable {
+
+    private:
+
+        /** Level of the blocks not tracked */
+        static const uint32_t NOT_TRACKED = UINT32_MAX;
+
+        /** Dense region of blocks starting at an address */
+        class Region {
+        public:
+
+            /** Start address of the region */
+            uint64_t start = 0;
+
+            /** Block of the first level in the table */
+            uint64_t first_blk = 0;
+
+            /** Level of the blocks from the first one */
+            std::vector<uint32_t> levels;
+
+            /**
+             * Constructor
+             * @param _start Start address of the region
+             */
+            explicit Region(uint64_t _start) : start(_start) {}
+        };
+
+        /** Block size */
+        const uint64_t WIDTH;
+
+        /** Regions sorted by start address, the highest first */
+        std::vector<Region> regions;
+
+        /** Tracked addresses outside the regions */
+        std::map<uint64_t, uint32_t> others;
+
+        /** Number of tracked addresses */
+        uint64_t count = 0;
+
+        /**
+         * Return the region and block of an address
+         * @param addr  Memory address
+         * @param blk   Block of the address in the region (Overwritten)
+         * @return      Index of the region of the address, -1 if outside the regions or not aligned
+         */
+        int find_region(uint64_t addr, uint64_t &blk) const {
+            for (int r = 0; r < regions.size(); ++r) {
+                if (addr < regions[r].start) continue;
+                auto offset = addr - regions[r].start;
+                if (offset % WIDTH != 0) return -1;
+                blk = offset / WIDTH;
+                return r;
+            }
+            return -1;
+        }
+
+        /**
+         * Check if a block of a region is tracked
+         * @param region    Region of the block
+         * @param blk       Block
+         * @return          True if tracked
+         */
+        static bool tracked_block(const Region &region, uint64_t blk) {
+            return blk >= region.first_blk && blk - region.first_blk < region.levels.size() &&
+                    region.levels[blk - region.first_blk] != NOT_TRACKED;
+        }
+
+        /**
+         * Extend the table of a region to include a block
+         * @param region    Region of the block
+         * @param blk       Block
+         * @return          Level of the block
+         */
+        static uint32_t &add_block(Region &region, uint64_t blk);
+
+        /**
+         * Stop tracking all the addresses between two addresses, both included
+         * @param min_addr  First address
+         * @param max_addr  Last address
+         */
+        void erase_range(uint64_t min_addr, uint64_t max_addr);
+
+    public:
+
+        /**
+         * Constructor
+         * @param START_ACT_ADDRESS     Start activation address
+         * @param START_WGT_ADDRESS     Start weight address
+         * @param _WIDTH                Block size
+         */
+        AddressTable(uint64_t START_ACT_ADDRESS, uint64_t START_WGT_ADDRESS, uint64_t _WIDTH);
+
+        /**
+         * Check if an address is tracked
+         * @param addr Memory address
+         * @return True if tracked
+         */
+        bool contains(uint64_t addr) const {
+            uint64_t blk = 0;
+            auto r = find_region(addr, blk);
+            return r < 0 ? others.find(addr) != others.end() : tracked_block(regions[r], blk);
+        }
+
+        /**
+         * Return the level of a tracked address
+         * @param addr Memory address
+         * @return Level of the address
+         */
+        uint32_t &at(uint64_t addr) {
+            uint64_t blk = 0;
+            auto r = find_region(addr, blk);
+            if (r < 0)
+                return others.at(addr);
+            if (!tracked_block(regions[r], blk))
+                throw std::out_of_range("Address not tracked");
+            return regions[r].levels[blk - regions[r].first_blk];
+        }
+
+        /**
+         * Start tracking an address, if it is already tracked its level does not change
+         * @param addr  Memory address
+         * @param level On-chip hierarchy level
+         */
+        void insert(uint64_t addr, uint32_t level);
+
+        /**
+         * Stop tracking an address
+         * @param addr Memory address
+         */
+        void erase(uint64_t addr);
+
+        /**
+         * Stop tracking a range of addresses
+         * If the last address is not tracked, all the addresses from the first one are erased, and if the first one
+         * is not tracked, only the last one.
+         * @param min_addr  First address of the range
+         * @param max_addr  Last address of the range
+         */
+        void erase(uint64_t min_addr, uint64_t max_addr);
+
+        /**
+         * Stop tracking all the addresses, keeping the memory of the tables
+         */
+        void clear();
+
+        /**
+         * Return the number of tracked addresses
+         * @return Number of tracked addresses
+         */
+        uint64_t size() const {
+            return count;
+        }
+
+        /**
+         * Check if no address is tracked
+         * @return True if empty
+         */
+        bool empty() const {
+            return count == 0;
+        }
+
+    };
+
+}
+
+#endif //DNNSIM_ADDRESSTABLE_H
@@ -267,7 +267,7 @@ namespace core {
          * Calculate cycles for all the tiles
          * @param tiles_data Processing information for all the tiles
          */
-        virtual void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) = 0;
+        virtual void process_tiles(const TilesData<T> &tiles_data) = 0;
 
         /**
          * Return true if ready to feed need data
@@ -308,6 +308,15 @@ namespace core {
          */
         virtual uint16_t computeBits(T act, T wgt) = 0;
 
+        /** Compute number of one bit multiplications of a dot product between activations and weights
+         * Implemented by every architecture as a non-virtual loop over its own per-pair function
+         * @param act   Activations (Contiguous)
+         * @param wgt   Weights (Contiguous)
+         * @param size  Number of pairs
+         * @return      Number of one bit multiplications
+         */
+        virtual uint64_t computeBits(const T *act, const T *wgt, uint64_t size) = 0;
+
     };
 
 }
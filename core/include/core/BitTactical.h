@@ -23,6 +23,9 @@ namespace core {
         /** Search shape for the scheduler: must be 'L' or 'T' */
         const char SEARCH_SHAPE;
 
+        /** Max number of threads launched for the scheduler */
+        const uint8_t N_THREADS;
+
         /** Number of concurrent multiplications per PE */
         uint32_t LANES;
 
@@ -35,9 +38,11 @@ namespace core {
          * @param _LOOKAHEAD_H      Value for scheduler lookahead
          * @param _LOOKASIDE_D      Value for scheduler lookaside
          * @param _SEARCH_SHAPE     Type of search
+         * @param _N_THREADS        Max number of threads launched for the scheduler
          */
-        BitTactical(uint32_t _LOOKAHEAD_H, uint32_t _LOOKASIDE_D, const char _SEARCH_SHAPE) : LOOKAHEAD_H(_LOOKAHEAD_H),
-                LOOKASIDE_D(_LOOKASIDE_D), SEARCH_SHAPE(_SEARCH_SHAPE), LANES(0) {
+        BitTactical(uint32_t _LOOKAHEAD_H, uint32_t _LOOKASIDE_D, const char _SEARCH_SHAPE, uint8_t _N_THREADS) :
+                LOOKAHEAD_H(_LOOKAHEAD_H), LOOKASIDE_D(_LOOKASIDE_D), SEARCH_SHAPE(_SEARCH_SHAPE),
+                N_THREADS(_N_THREADS), LANES(0) {
 
             if (SEARCH_SHAPE == 'L') {
 
@@ -87,10 +92,11 @@ namespace core {
 
         /**
          * Check the whole rows is zeroes
-         * @param buffer Schedule buffer row
+         * @param buffer Schedule buffer set
+         * @param time Row of the buffer set
          * @return True if all row is zero
          */
-        bool check_zero_line(const BufferRow<T> &buffer);
+        bool check_zero_line(const BufferSet<T> &buffer, uint64_t time);
 
         /**
          * Promote one effectual candidate to the ineffectual value position
@@ -111,12 +117,16 @@ namespace core {
 
         /**
          * Schedule buffer set using original schedule
+         * The groups of lanes only share the zero line skipping, so they are scheduled in parallel time by time
          * @param buffer Buffer set to scheduler (Overwritten)
+         * @param threads Number of threads to schedule the groups of lanes
          */
-        void original_schedule(BufferSet<T> &buffer);
+        void original_schedule(BufferSet<T> &buffer, int threads);
 
         /**
          * Schedule buffer
+         * The buffer sets are independent and scheduled in parallel, or their groups of lanes if there are fewer
+         * sets than threads. The result is the same as the sequential schedule.
          * @param buffer Buffer to scheduler (Overwritten)
          * @param _LANES Number of lanes
          */
@@ -22,6 +22,31 @@ namespace core {
     template <typename T>
     class Control {
 
+    public:
+
+        /** State carried from one layer to the next one of the same sample */
+        class LayerState {
+        public:
+
+            /** True if activations on-chip for the next layer */
+            bool next_layer_act_on_chip = false;
+
+            /** Next off-chip activation address to allocate */
+            uint64_t next_act_address = 0;
+
+            /** Next off-chip weight address to allocate */
+            uint64_t next_wgt_address = 0;
+
+            /** Next off-chip output address to allocate */
+            uint64_t next_out_address = 0;
+
+            bool operator==(const LayerState &other) const {
+                return next_layer_act_on_chip == other.next_layer_act_on_chip &&
+                        next_act_address == other.next_act_address && next_wgt_address == other.next_wgt_address &&
+                        next_out_address == other.next_out_address;
+            }
+        };
+
     protected:
 
         /** On-chip stage memory node */
@@ -51,10 +76,46 @@ namespace core {
 
             /** Output activation addresses to write */
             std::vector<AddressRange> write_addresses;
+
+            virtual ~Node() = default;
+
+            /** Clear the node to describe a new stage, keeping the memory of the addresses */
+            virtual void reset() {
+                evict_act = false;
+                evict_out = false;
+                evict_wgt = false;
+                layer_act_on_chip = false;
+                read_act_addresses.clear();
+                read_psum_addresses.clear();
+                read_wgt_addresses.clear();
+                write_addresses.clear();
+            }
         };
 
-        /** List of on-chip stages */
-        std::vector<std::shared_ptr<Node>> on_chip_graph;
+        /** Node of the current on-chip stage, the nodes are generated on demand and it is reused by the next ones */
+        std::shared_ptr<Node> on_chip_node;
+
+        /**
+         * Return the node of the current on-chip stage cleared to describe the next one
+         * @tparam N Node type of the dataflow, the same for all the layers
+         * @return Empty node
+         */
+        template <typename N>
+        std::shared_ptr<N> reuse_node() {
+            if (!on_chip_node)
+                on_chip_node = std::make_shared<N>();
+            auto node = std::static_pointer_cast<N>(on_chip_node);
+            node->reset();
+            return node;
+        }
+
+        /**
+         * Return the node of the current on-chip stage
+         * @return Current node
+         */
+        const std::shared_ptr<Node> &current_node() const {
+            return on_chip_node;
+        }
 
         std::shared_ptr<uint64_t> global_cycle;
 
@@ -124,16 +185,29 @@ namespace core {
         /** True if activations on-chip for the next layer */
         bool next_layer_act_on_chip = false;
 
+        /**
+         * Return the off-chip data size of a precision
+         * @param prec Precision in bits
+         * @return Data size in bits
+         */
+        uint32_t dram_data_size(uint32_t prec) const;
+
         /**
          * Generate memory mapping for input data
          */
         virtual void generate_memory_maps() = 0;
 
         /**
-         * Generate execution graph
+         * Generate execution graph, up to the node of the first on-chip stage
          */
         virtual void generate_execution_graph() = 0;
 
+        /**
+         * Generate the node of the next on-chip stage of the execution graph
+         * @return False if no more on-chip stages
+         */
+        virtual bool generate_next_node() = 0;
+
     public:
 
         /**
@@ -242,6 +316,35 @@ namespace core {
         */
         virtual std::string dataflow() = 0;
 
+        /**
+         * Return the state carried to the next layer
+         * @return State for the next layer
+         */
+        virtual LayerState getLayerState() const;
+
+        /**
+         * Restore the state carried from the previous layer
+         * @param state State left by the previous layer
+         */
+        virtual void setLayerState(const LayerState &state);
+
+        /**
+         * Return the state carried to the next layer from the shapes of the current one, without configuring the
+         * control
+         * @param state     State left by the previous layer
+         * @param act_shape Activations shape of one sample
+         * @param wgt_shape Weights shape
+         * @param act_prec  Activations precision
+         * @param wgt_prec  Weight precision
+         * @param _linear   True if linear layer
+         * @param __3dim    True if layer has 3 dimensions
+         * @param _stride   Stride
+         * @return State for the next layer
+         */
+        virtual LayerState next_layer_state(const LayerState &state, const std::vector<size_t> &act_shape,
+                const std::vector<size_t> &wgt_shape, uint32_t act_prec, uint32_t wgt_prec, bool _linear,
+                bool __3dim, int _stride) const;
+
         /**
          * Configure control values for the current layer
          * @param _act      Pointer to activation values
@@ -329,7 +432,7 @@ namespace core {
          * @param tiles_data Current data to process in the tiles
          * @return True if data to write
          */
-        bool check_if_write_output(const std::shared_ptr<TilesData<T>> &tiles_data);
+        bool check_if_write_output(const TilesData<T> &tiles_data);
 
     };
 
@@ -50,11 +50,14 @@ namespace core {
         /** Memory system */
         DRAMSim::MultiChannelMemorySystem *dram_interface;
 
-        /** Transactions queue */
-        std::queue<std::tuple<uint64_t, bool>> request_queue;
+        /** Transactions queue, the ones before the head are already issued */
+        std::vector<std::tuple<uint64_t, bool>> request_queue;
 
-        /** List of required addresses waiting to be transferred to on-chip */
-        std::set<uint64_t> waiting_addresses;
+        /** Next transaction of the queue to issue */
+        uint64_t request_head = 0;
+
+        /** Required addresses waiting to be transferred to on-chip */
+        AddressTable waiting_addresses;
 
         /* STATISTICS */
 
@@ -77,6 +80,11 @@ namespace core {
          */
         void transaction_request(uint64_t address, bool isWrite);
 
+        /**
+         * Request the next transaction of the queue to the memory system, if there is one
+         */
+        void issue_queued_request();
+
     public:
 
         /**
@@ -95,7 +103,7 @@ namespace core {
          * @param _system_conf          System configuration file
          * @param _network              Network name
          */
-        DRAM(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
+        DRAM(const std::shared_ptr<AddressTable> &_tracked_data,
                 const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
                 const std::shared_ptr<AddressRange> &_wgt_addresses, uint32_t _WIDTH, uint32_t _SIZE,
                 uint32_t _BASE_DATA_SIZE, uint64_t _clock_freq, uint64_t _START_ACT_ADDRESS, uint64_t _START_WGT_ADDRESS,
@@ -103,7 +111,8 @@ namespace core {
                 Memory<T>(_tracked_data, _act_addresses, _out_addresses, _wgt_addresses), WIDTH(_WIDTH),
                 START_ACT_ADDRESS(_START_ACT_ADDRESS), START_WGT_ADDRESS(_START_WGT_ADDRESS), SIZE(_SIZE),
                 BASE_VALUES_PER_BLOCK(64 / _BASE_DATA_SIZE), BASE_DATA_SIZE(_BASE_DATA_SIZE), ACT_VALUES_PER_BLOCK(0),
-                ACT_DATA_SIZE(0), WGT_VALUES_PER_BLOCK(0), WGT_DATA_SIZE(0) {
+                ACT_DATA_SIZE(0), WGT_VALUES_PER_BLOCK(0), WGT_DATA_SIZE(0),
+                waiting_addresses(_START_ACT_ADDRESS, _START_WGT_ADDRESS, _WIDTH) {
 
             dram_interface = DRAMSim::getMemorySystemInstance(_dram_conf, _system_conf, "./DRAMSim2/",
                     "DNNsim_" + _network, _SIZE);
@@ -206,6 +215,9 @@ namespace core {
         /** Update memory interface one cycle */
         void cycle();
 
+        /** Drop the queued transactions and bring the memory system back to its initial timing state */
+        void reset();
+
         /** Configure memory for current layer parameters */
         void configure_layer() override {}; // Unused
 
@@ -218,7 +230,7 @@ namespace core {
 
         /**
          * Take a list of addresses and compress them in ranges
-         * @param addresses List of addresses
+         * @param addresses List of addresses in increasing order, repeated addresses are skipped
          * @return Compressed addresses
          */
         std::vector<AddressRange> compress_addresses(const std::vector<uint64_t> &addresses);
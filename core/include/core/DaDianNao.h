@@ -45,7 +45,7 @@ namespace core {
          * Calculate cycles for all the tiles
          * @param tiles_data Processing information for all the tiles
          */
-        void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) override;
+        void process_tiles(const TilesData<T> &tiles_data) override;
 
         /* POTENTIALS */
 
@@ -68,6 +68,14 @@ namespace core {
          */
         uint16_t computeBits(T act, T wgt) override;
 
+        /** Compute number of one bit multiplications of a dot product between activations and weights
+         * @param act           Activations (Contiguous)
+         * @param wgt           Weights (Contiguous)
+         * @param size          Number of pairs
+         * @return              Number of one bit multiplications
+         */
+        uint64_t computeBits(const T *act, const T *wgt, uint64_t size) override;
+
     public:
 
         /** Constructor
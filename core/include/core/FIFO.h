@@ -5,12 +5,22 @@
 
 namespace core {
 
+    /**
+     * First In First Out eviction policy
+     * The addresses are kept in a ring buffer that only grows until the bank is full.
+     */
     class FIFO : public EvictionPolicy {
 
     private:
 
-        /** FIFO eviction queue */
-        std::queue<uint64_t> fifo;
+        /** FIFO eviction ring buffer */
+        std::vector<uint64_t> fifo;
+
+        /** Position of the oldest address */
+        uint64_t head = 0;
+
+        /** Number of addresses */
+        uint64_t count = 0;
 
         /**
          * Flush all the addresses
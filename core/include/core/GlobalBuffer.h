@@ -134,7 +134,7 @@ namespace core {
          * @param _ACT_POLICY           Activation eviction policy
          * @param _WGT_POLICY           Weight eviction policy
          */
-        GlobalBuffer(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
+        GlobalBuffer(const std::shared_ptr<AddressTable> &_tracked_data,
                 const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
                 const std::shared_ptr<AddressRange> &_wgt_addresses, uint32_t _ACT_LEVELS, uint32_t _WGT_LEVELS,
                 const std::vector<uint64_t> &_ACT_SIZE, const std::vector<uint64_t> &_WGT_SIZE, uint32_t _ACT_OUT_BANKS,
@@ -338,27 +338,27 @@ namespace core {
          * @param read_act          Update to True if activations to be read (Overwritten)
          * @param layer_act_on_chip Layer activation on-chip flag
          */
-        void act_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool layer_act_on_chip, bool &read_act);
+        void act_read_request(const TilesData<T> &tiles_data, bool layer_act_on_chip, bool &read_act);
 
         /**
          * Read request to the output banks
          * @param tiles_data        Data to be read from the banks
          * @param read_psum         Update to True if partial sums to be read (Overwritten)
          */
-        void psum_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool &read_psum);
+        void psum_read_request(const TilesData<T> &tiles_data, bool &read_psum);
 
         /**
          * Read request to the weight banks
          * @param tiles_data        Data to be read from the banks
          * @param read_wgt          Update to True if weights to be read (Overwritten)
          */
-        void wgt_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool &read_wgt);
+        void wgt_read_request(const TilesData<T> &tiles_data, bool &read_wgt);
 
         /**
          * Write request to the output banks
          * @param tiles_data        Data to be written to the banks
          */
-        void write_request(const std::shared_ptr<TilesData<T>> &tiles_data);
+        void write_request(const TilesData<T> &tiles_data);
 
         /**
          * Evict activations and/or weights from on-chip
@@ -5,15 +5,90 @@
 
 namespace core {
 
+    /**
+     * Least Recently Used eviction policy
+     * The addresses live in slots linked by index from the most to the least recently used, and the slots of the
+     * addresses are found in an open addressing table. Evicted slots are reused, so the memory only grows until the
+     * bank is full.
+     */
     class LRU : public EvictionPolicy {
 
     private:
 
-        /** Addresses eviction list */
-        std::list<uint64_t> data;
+        /** Slot index that marks the end of a list or an empty table entry */
+        static const uint32_t NO_SLOT = UINT32_MAX;
 
-        /** Least Recently Used tracking tree */
-        std::unordered_map<uint64_t, std::list<uint64_t>::iterator> lru;
+        /** Address of every slot */
+        std::vector<uint64_t> slot_addr;
+
+        /** More recently used slot of every slot */
+        std::vector<uint32_t> prev_slot;
+
+        /** Less recently used slot of every slot, or next free slot */
+        std::vector<uint32_t> next_slot;
+
+        /** Most recently used slot */
+        uint32_t head = NO_SLOT;
+
+        /** Least recently used slot */
+        uint32_t tail = NO_SLOT;
+
+        /** First free slot */
+        uint32_t free_head = NO_SLOT;
+
+        /** Number of addresses */
+        uint64_t count = 0;
+
+        /** Slots by address hash, the size is a power of two */
+        std::vector<uint32_t> index;
+
+        /** Number of bits of the address hash */
+        int index_bits = 0;
+
+        /**
+         * Return the position of an address in the index table
+         * @param addr Memory address
+         * @return Home position of the address
+         */
+        uint64_t hash(uint64_t addr) const {
+            return (addr * 0x9E3779B97F4A7C15ULL) >> (64 - index_bits);
+        }
+
+        /**
+         * Return the position in the index table of the slot of an address
+         * @param addr Memory address
+         * @return Position of the slot, the size of the table if the address is not tracked
+         */
+        uint64_t find_position(uint64_t addr) const;
+
+        /**
+         * Add a slot to the index table
+         * @param slot Slot of the address
+         */
+        void index_slot(uint32_t slot);
+
+        /**
+         * Remove a slot from the index table, moving back the slots after it
+         * @param pos Position of the slot in the table
+         */
+        void unindex_position(uint64_t pos);
+
+        /**
+         * Double the index table and add the slots again
+         */
+        void grow_index();
+
+        /**
+         * Link a slot as the most recently used
+         * @param slot Slot
+         */
+        void link_front(uint32_t slot);
+
+        /**
+         * Unlink a slot from the list
+         * @param slot Slot
+         */
+        void unlink(uint32_t slot);
 
         /**
          * Flush all the addresses
@@ -41,7 +41,7 @@ namespace core {
          * @param _READ_DELAY           Read delay in cycles
          * @param _WRITE_DELAY          Write delay in cycles
          */
-        LocalBuffer(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
+        LocalBuffer(const std::shared_ptr<AddressTable> &_tracked_data,
                 const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
                 const std::shared_ptr<AddressRange> &_wgt_addresses, uint32_t _ROWS, uint32_t _READ_DELAY,
                 uint32_t _WRITE_DELAY) : Memory<T>(_tracked_data, _act_addresses, _out_addresses, _wgt_addresses),
@@ -91,8 +91,7 @@ namespace core {
 
         /**
          * Calculate the cycles for the given processing engine
-         * @param row 1D vector of input values
-         * @param idx Column/row index within the row
+         * @param values Input values of the lanes, contiguous
          * @param lanes Number of concurrent lanes
          * @param n_mask Negation mask
          * @param signed_data True if signed values
@@ -100,26 +99,26 @@ namespace core {
          * @param max_group_bit Maximum bit position (overwritten)
          * @param blk Spatial composition block index
          */
-        void process_pe(const BufferRow<T> &row, int idx, int lanes, uint16_t n_mask, bool signed_data,
-                int &min_group_bit, int &max_group_bit, int blk);
+        void process_pe(const T *values, int lanes, uint16_t n_mask, bool signed_data, int &min_group_bit,
+                int &max_group_bit, int blk);
 
         /**
          * Calculate cycles for linear layers
          * @param tile_data Processing information for all the tiles
          */
-        void process_linear(const std::shared_ptr<TilesData<T>> &tiles_data);
+        void process_linear(const TilesData<T> &tiles_data);
 
         /**
          * Calculate cycles for matrix multiply
          * @param tile_data Processing information for all the tiles
          */
-        void process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data);
+        void process_mmul(const TilesData<T> &tiles_data);
 
         /**
          * Calculate cycles for all the tiles
          * @param tiles_data Processing information for all the tiles
          */
-        void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) override;
+        void process_tiles(const TilesData<T> &tiles_data) override;
 
         /* POTENTIALS */
 
@@ -142,6 +141,14 @@ namespace core {
          */
         uint16_t computeBits(T act, T wgt) override;
 
+        /** Compute number of one bit multiplications of a dot product between activations and weights
+         * @param act           Activations (Contiguous)
+         * @param wgt           Weights (Contiguous)
+         * @param size          Number of pairs
+         * @return              Number of one bit multiplications
+         */
+        uint64_t computeBits(const T *act, const T *wgt, uint64_t size) override;
+
     public:
 
         /** Constructor
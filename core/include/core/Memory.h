@@ -1,7 +1,7 @@
 #ifndef DNNSIM_MEMORY_H
 #define DNNSIM_MEMORY_H
 
-#include "Utils.h"
+#include "AddressTable.h"
 
 namespace core {
 
@@ -17,7 +17,7 @@ namespace core {
     protected:
 
         /** Current tracked data on-chip: Tuple <Address, on-chip hierarchy level> */
-        std::shared_ptr<std::map<uint64_t, uint32_t>> tracked_data;
+        std::shared_ptr<AddressTable> tracked_data;
 
         /** Address range for activations */
         std::shared_ptr<AddressRange> act_addresses;
@@ -40,7 +40,7 @@ namespace core {
          * @param _out_addresses    Output activation addresses range
          * @param _wgt_addresses    Weight addresses range
          */
-        Memory(const std::shared_ptr<std::map<uint64_t, uint32_t>> &_tracked_data,
+        Memory(const std::shared_ptr<AddressTable> &_tracked_data,
                 const std::shared_ptr<AddressRange> &_act_addresses, const std::shared_ptr<AddressRange> &_out_addresses,
                 const std::shared_ptr<AddressRange> &_wgt_addresses) {
             tracked_data = _tracked_data;
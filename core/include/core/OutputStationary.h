@@ -40,34 +40,46 @@ namespace core {
 
             /** Use the previous activation buffer from previous node */
             bool use_prev_buffer = false;
+
+            void reset() override {
+                Control<T>::Node::reset();
+                recurrence = 0;
+                time_step = 0;
+                max_time = 0;
+                groups.clear();
+                window_sets.clear();
+                filter_sets.clear();
+                use_prev_buffer = false;
+            }
         };
 
         /** Weight buffer */
         Buffer<T> weight_buffer;
 
-        /** Weight Addresses buffer */
-        AddressBuffer wgt_address_buffer;
+        /** First weight address of every row of the weight buffer in filter set and time order, the addresses of a
+         * row are consecutive blocks */
+        std::vector<uint64_t> wgt_row_addresses;
+
+        /** Number of weight addresses of a row of the weight buffer */
+        uint64_t wgt_row_accesses = 0;
 
         /** Weight Addresses map */
         std::vector<AddressRange> wgt_address_map;
 
-        /** Weight banks buffer */
-        BankBuffer wgt_bank_buffer;
-
         /** Weight End time */
         std::vector<uint64_t> wgt_end_time;
 
-        /** Window buffer */
-        BufferSet<T> window_buffer;
+        /** Window buffer, shared with the tiles that read it */
+        std::shared_ptr<BufferSet<T>> window_buffer;
 
-        /** Window Addresses buffer */
-        AddressBufferSet window_address_buffer;
+        /** Window Addresses buffer, shared with the tiles that read it */
+        std::shared_ptr<AddressBufferSet> window_address_buffer;
 
         /** Activation Addresses map */
         AddressMap act_address_map;
 
-        /** Window Bank buffer */
-        BankBufferSet window_bank_buffer;
+        /** Window Bank buffer, shared with the tiles that read it */
+        std::shared_ptr<BankBufferSet> window_bank_buffer;
 
         /** Activation Bank map */
         ActBankMap act_bank_map;
@@ -105,11 +117,14 @@ namespace core {
         /** Maximum buffer depth */
         uint32_t max_buffer_time = 0;
 
-        /** List of coordinates for the windows */
-        std::vector<WindowCoord> windows;
+        /** List of coordinates for the windows, shared with the tiles that read it */
+        std::shared_ptr<std::vector<WindowCoord>> windows;
+
+        /** List of filters per tile, shared with the tiles that read it */
+        std::shared_ptr<std::vector<std::vector<int>>> filters;
 
-        /** List of filters per tile */
-        std::vector<std::vector<int>> filters;
+        /** Coordinates of the columns for linear layers */
+        std::shared_ptr<std::vector<WindowCoord>> linear_windows;
 
         /** Group iterator */
         int group_it = 0;
@@ -172,6 +187,30 @@ namespace core {
          */
         void fill_weight_buffer();
 
+        /**
+         * Return the number of weight addresses of a row of the weight buffer
+         * @param lanes                 Effective lanes
+         * @param rows                  Effective rows
+         * @param wgt_values_per_block  Weight values per off-chip block
+         * @return                      Addresses of a row
+         */
+        uint64_t weight_row_accesses(uint32_t lanes, uint32_t rows, uint32_t wgt_values_per_block) const;
+
+        /**
+         * Return the weight addresses of a row of the weight buffer
+         * @param set   Filter set
+         * @param time  Time of the row
+         * @return      Addresses of the row, not valid addresses if the row is skipped
+         */
+        StridedAddressRow wgt_address_row(uint64_t set, uint64_t time) const;
+
+        /**
+         * Return the weight banks of a row of the weight buffer, the same for every row of a filter set
+         * @param set   Filter set
+         * @return      Banks of the row
+         */
+        RoundRobinBankRow wgt_bank_row(uint64_t set) const;
+
         /**
          * Fill the window buffer with the activations to process
          */
@@ -218,6 +257,35 @@ namespace core {
                 const std::shared_ptr<PPU<T>> &_ppu) : Control<T>(_scheduler,_dram, _gbuffer, _abuffer, _pbuffer,
                 _wbuffer, _obuffer, _composer, _ppu) {}
 
+        /**
+         * Return the state carried to the next layer, including the off-chip address allocation
+         * @return State for the next layer
+         */
+        typename Control<T>::LayerState getLayerState() const override;
+
+        /**
+         * Restore the state carried from the previous layer, including the off-chip address allocation
+         * @param state State left by the previous layer
+         */
+        void setLayerState(const typename Control<T>::LayerState &state) override;
+
+        /**
+         * Return the state carried to the next layer from the shapes of the current one, including the off-chip
+         * address allocation
+         * @param state     State left by the previous layer
+         * @param act_shape Activations shape of one sample
+         * @param wgt_shape Weights shape
+         * @param act_prec  Activations precision
+         * @param wgt_prec  Weight precision
+         * @param _linear   True if linear layer
+         * @param __3dim    True if layer has 3 dimensions
+         * @param _stride   Stride
+         * @return State for the next layer
+         */
+        typename Control<T>::LayerState next_layer_state(const typename Control<T>::LayerState &state,
+                const std::vector<size_t> &act_shape, const std::vector<size_t> &wgt_shape, uint32_t act_prec,
+                uint32_t wgt_prec, bool _linear, bool __3dim, int _stride) const override;
+
     };
 
 }
@@ -37,12 +37,18 @@ namespace core {
         /** Number of banks */
         const int BANKS;
 
+        /** Max number of threads launched for the simulation */
+        const uint8_t N_THREADS = 1;
+
         /** Enable fast mode: only one sample */
         const bool FAST_MODE = false;
 
         /** Avoid std::out messages */
         const bool QUIET = false;
 
+        /** Work units simulated by this process */
+        const sys::Shard SHARD;
+
         /* CYCLES */
 
         /** Calculate in which bank the output activation is mapped
@@ -63,18 +69,18 @@ namespace core {
         };
 
         struct Tile_stats {
-            uint32_t cycles = 0;
-            uint32_t dense_cycles = 0;
-            uint32_t mults = 0;
-            uint32_t idle_bricks = 0;
-            uint32_t idle_conflicts = 0;
-            uint32_t idle_pe = 0;
-            uint32_t weight_buff_reads = 0;
-            uint32_t act_buff_reads = 0;
-            uint32_t accumulator_updates = 0;
-            uint32_t i_loop = 0;
-            uint32_t f_loop = 0;
-            uint32_t offchip_weight_reads = 0;
+            uint64_t cycles = 0;
+            uint64_t dense_cycles = 0;
+            uint64_t mults = 0;
+            uint64_t idle_bricks = 0;
+            uint64_t idle_conflicts = 0;
+            uint64_t idle_pe = 0;
+            uint64_t weight_buff_reads = 0;
+            uint64_t act_buff_reads = 0;
+            uint64_t accumulator_updates = 0;
+            uint64_t i_loop = 0;
+            uint64_t f_loop = 0;
+            uint64_t offchip_weight_reads = 0;
 
         };
 
@@ -107,11 +113,12 @@ namespace core {
          * @param padding   Padding for the layer
          * @param act       Activations for the layer
          * @param wgt       Weights for the layer
+         * @param threads   Number of threads to evaluate the PEs of the grid
          * @return          Return stats for the current tile
          */
         Tile_stats computeSCNNTile(int n, int ct, int ck, int kc, int tw, int th, uint64_t X, uint64_t Y, int Kc,
                 uint64_t K, uint64_t W, uint64_t H, uint64_t R, uint64_t S, int stride, int padding,
-                const base::Array<T> &act, const base::Array<T> &wgt);
+                const base::Array<T> &act, const base::Array<T> &wgt, int threads);
 
         /* AUXILIARY FUNCTIONS */
 
@@ -151,7 +158,7 @@ namespace core {
          * Calculate cycles for all the tiles
          * @param tiles_data Processing information for all the tiles
          */
-        void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) override;
+        void process_tiles(const TilesData<T> &tiles_data) override;
 
         /* POTENTIALS */
 
@@ -174,6 +181,14 @@ namespace core {
          */
         uint16_t computeBits(T act, T wgt) override;
 
+        /** Compute number of one bit multiplications of a dot product between activations and weights
+         * @param act           Activations (Contiguous)
+         * @param wgt           Weights (Contiguous)
+         * @param size          Number of pairs
+         * @return              Number of one bit multiplications
+         */
+        uint64_t computeBits(const T *act, const T *wgt, uint64_t size) override;
+
     public:
 
         /** Constructor
@@ -183,14 +198,19 @@ namespace core {
          * @param _F            Row multipliers per PE
          * @param _OUT_ACC_SIZE Output accumulator size
          * @param _BANKS        Number of banks
+         * @param _N_THREADS    Max number of threads launched for the simulation
          * @param _FAST_MODE    Enable fast mode to simulate only one sample
          * @param _QUIET        Avoid std::out messages
+         * @param _SHARD        Work units simulated by this process
          */
         SCNN(uint32_t _Wt, uint32_t _Ht, uint32_t _I, uint32_t _F, uint32_t _OUT_ACC_SIZE, uint32_t _BANKS,
-             bool _FAST_MODE, bool _QUIET) : Wt(_Wt), Ht(_Ht), I(_I), F(_F), OUT_ACC_SIZE(_OUT_ACC_SIZE), BANKS(_BANKS),
-             QUIET(_QUIET) {}
+             uint8_t _N_THREADS, bool _FAST_MODE, bool _QUIET, const sys::Shard &_SHARD) : Wt(_Wt), Ht(_Ht), I(_I),
+             F(_F), OUT_ACC_SIZE(_OUT_ACC_SIZE), BANKS(_BANKS), N_THREADS(_N_THREADS), QUIET(_QUIET), SHARD(_SHARD) {}
 
         /** Run the timing simulator of the architecture
+         * The tiles of every sample and group of output channels are distributed among the threads, or the PEs of
+         * the grid when there are not enough tiles. Partial stats are reduced in order once all the threads are done.
+         * Only the layers and samples of the shard are simulated, sharded runs dump them as partial results.
          * @param network   Network we want to simulate
          */
         void run(const base::Network<T> &network);
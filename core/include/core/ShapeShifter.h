@@ -112,26 +112,26 @@ namespace core {
          * @param min_group_bit Minor bit for the group (Overwritten)
          * @param max_group_bit Leading bit for the group (Overwritten)
          */
-        void process_pe(const BufferSet<T> &act_row, const BufferRow<T> &wgt_row, int window_idx, int filter_idx,
+        void process_pe(const BufferSlice<T> &act_row, const BufferRow<T> &wgt_row, int window_idx, int filter_idx,
                 int lanes, int time, int &min_group_bit, int &max_group_bit, int act_blk);
 
         /**
          * Calculate cycles for linear layers
          * @param tile_data Processing information for all the tiles
          */
-        void process_linear(const std::shared_ptr<TilesData<T>> &tiles_data);
+        void process_linear(const TilesData<T> &tiles_data);
 
         /**
          * Calculate cycles for matrix multiply
          * @param tile_data Processing information for all the tiles
          */
-        void process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data);
+        void process_mmul(const TilesData<T> &tiles_data);
 
         /**
          * Calculate cycles for all the tiles
          * @param tiles_data Processing information for all the tiles
          */
-        void process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) override;
+        void process_tiles(const TilesData<T> &tiles_data) override;
 
         /* POTENTIALS */
 
@@ -154,6 +154,14 @@ namespace core {
          */
         uint16_t computeBits(T act, T wgt) override;
 
+        /** Compute number of one bit multiplications of a dot product between activations and weights
+         * @param act           Activations (Contiguous)
+         * @param wgt           Weights (Contiguous)
+         * @param size          Number of pairs
+         * @return              Number of one bit multiplications
+         */
+        uint64_t computeBits(const T *act, const T *wgt, uint64_t size) override;
+
     public:
 
         /** Constructor
@@ -30,37 +30,129 @@ namespace core {
 
     /**
      * Inference pipeline
+     * The data of the tiles lives in a pool of slots that are reused once they retire. Every stage is a ring buffer
+     * of slot indices, so moving data between stages does not allocate memory.
      * @tparam T Data type of the simulation
      */
     template <typename T>
     class Pipeline {
-    public:
+    private:
+
+        /**
+         * Queue of slot indices with a fixed capacity
+         */
+        class SlotRing {
+        private:
+
+            /** Slot indices */
+            std::vector<uint32_t> ring;
+
+            /** Position of the first slot index */
+            uint32_t head = 0;
+
+            /** Number of slot indices */
+            uint32_t count = 0;
+
+        public:
+
+            /**
+             * Constructor
+             * @param capacity Maximum number of slot indices
+             */
+            explicit SlotRing(uint32_t capacity) : ring(capacity, 0) {}
+
+            /**
+             * Increase the capacity, keeping the slot indices in order
+             * @param capacity New maximum number of slot indices
+             */
+            void reserve(uint32_t capacity) {
+                if (capacity <= ring.size()) return;
+                std::vector<uint32_t> new_ring(capacity, 0);
+                for (uint32_t i = 0; i < count; ++i)
+                    new_ring[i] = ring[(head + i) % ring.size()];
+                ring.swap(new_ring);
+                head = 0;
+            }
+
+            void push(uint32_t slot) {
+                ring[(head + count) % ring.size()] = slot;
+                count++;
+            }
+
+            uint32_t front() const {
+                return ring[head];
+            }
+
+            void pop() {
+                head = (head + 1) % ring.size();
+                count--;
+            }
+
+            bool empty() const {
+                return count == 0;
+            }
+
+        };
+
+        /** Data slots, a deque keeps the references valid when the pool grows */
+        std::deque<TilesData<T>> slots;
+
+        /** Indices of the slots not in the pipeline */
+        std::vector<uint32_t> free_slots;
 
-        /** 2D data tracking pipeline */
-        std::vector<std::queue<std::shared_ptr<TilesData<T>>>> pipeline;
+        /** Slot indices in every stage */
+        std::vector<SlotRing> pipeline;
+
+        /** Number of tiles of the data */
+        uint64_t tiles = 0;
+
+        /** Add a new slot to the pool, only while the pipeline fills up */
+        void grow() {
+            slots.emplace_back(tiles);
+            free_slots.push_back((uint32_t)slots.size() - 1);
+            for (auto &stage : pipeline)
+                stage.reserve((uint32_t)slots.size());
+        }
+
+    public:
 
         /**
          * Constructor
          * @param _stages Number of pipeline stages
+         * @param _tiles Number of tiles of the data
+         */
+        Pipeline(uint64_t _stages, uint64_t _tiles) : tiles(_tiles) {
+            // One slot per stage and the one being filled
+            pipeline = std::vector<SlotRing>(_stages, SlotRing((uint32_t)_stages + 1));
+            for (uint64_t s = 0; s <= _stages; ++s) grow();
+        }
+
+        /**
+         * Return a free slot to fill with the next data, it enters the pipeline with fetch_data
+         * @return Empty data for the tiles
          */
-        explicit Pipeline(uint64_t _stages) {
-            pipeline = std::vector<std::queue<std::shared_ptr<TilesData<T>>>>(_stages,
-                    std::queue<std::shared_ptr<TilesData<T>>>());
+        TilesData<T> &next_data() {
+            if (free_slots.empty()) grow();
+            auto &tiles_data = slots[free_slots.back()];
+            tiles_data.reset();
+            return tiles_data;
         }
 
         /**
-         * Fetch data into the pipeline
-         * @param tiles_data Input data
+         * Fetch the data of the slot returned by next_data into the pipeline
          */
-        void fetch_data(const TilesData<T> &tiles_data) {
-            pipeline.front().emplace(std::make_shared<TilesData<T>>(tiles_data));
+        void fetch_data() {
+            pipeline.front().push(free_slots.back());
+            free_slots.pop_back();
         }
 
         /**
-         * Retire data in the given stage
+         * Retire data in the given stage, releasing the dataflow buffers it shares
          * @param stage Pipeline stage
          */
         void end_stage(Stage stage) {
+            slots[pipeline[stage].front()].reset();
+            free_slots.push_back(pipeline[stage].front());
             pipeline[stage].pop();
         }
 
@@ -69,7 +161,7 @@ namespace core {
          * @param stage Pipeline stage
          */
         void move_stage(Stage stage) {
-            pipeline[stage + 1].emplace(pipeline[stage].front());
+            pipeline[stage + 1].push(pipeline[stage].front());
             pipeline[stage].pop();
         }
 
@@ -78,8 +170,8 @@ namespace core {
          * @param stage Pipeline stage
          * @return Data
          */
-        const std::shared_ptr<TilesData<T>> &getData(Stage stage) {
-            return pipeline[stage].front();
+        TilesData<T> &getData(Stage stage) {
+            return slots[pipeline[stage].front()];
         }
 
         /**
@@ -122,6 +214,9 @@ namespace core {
 
     private:
 
+        /** Max number of threads launched for the simulation */
+        const uint8_t N_THREADS = 1;
+
         /** Enable fast mode: only one sample */
         const bool FAST_MODE = false;
 
@@ -131,22 +226,66 @@ namespace core {
         /** Check the correctness of the simulations */
         const bool CHECK = false;
 
+        /** Work units simulated by this process */
+        const sys::Shard SHARD;
+
+        /** Convert the activations of the whole batch and the weights of a layer to the architecture format
+         * @param layer     Layer we want to simulate
+         * @param arch      Pointer to the architecture that converts the data
+         * @param act       Activations of the batch as 4D array (Overwritten)
+         * @param wgt       Weights of the layer as 4D array (Overwritten)
+         */
+        void convert_layer(const base::Layer<T> &layer, const std::shared_ptr<Architecture<T>> &arch,
+                base::Array<T> &act, base::Array<T> &wgt);
+
+        /** Read the activations of one sample and the weights of a layer in the format the dataflow expects
+         * The activations and weights are views of the converted data of the layer
+         * @param layer     Layer we want to simulate
+         * @param layer_act Converted activations of the batch
+         * @param layer_wgt Converted weights of the layer
+         * @param sample    Sample of the activations
+         * @param act       Activations of the sample (Overwritten)
+         * @param wgt       Weights of the layer (Overwritten)
+         * @return Stride of the layer after reshaping
+         */
+        int read_layer(const base::Layer<T> &layer, const base::Array<T> &layer_act, const base::Array<T> &layer_wgt,
+                int sample, std::shared_ptr<base::Array<T>> &act, std::shared_ptr<base::Array<T>> &wgt);
+
+        /** Return the shapes that read_layer gives to the activations of one sample and the weights of a layer,
+         * without reading the values
+         * @param layer     Layer we want to simulate
+         * @param layer_act Converted activations of the batch
+         * @param layer_wgt Converted weights of the layer
+         * @param act_shape Activations shape of one sample (Overwritten)
+         * @param wgt_shape Weights shape (Overwritten)
+         * @return Stride of the layer after reshaping
+         */
+        int layer_shapes(const base::Layer<T> &layer, const base::Array<T> &layer_act,
+                const base::Array<T> &layer_wgt, std::vector<size_t> &act_shape, std::vector<size_t> &wgt_shape);
+
     public:
 
         /** Constructor
+         * @param _N_THREADS    Max number of threads launched for the simulation
          * @param _FAST_MODE    Enable fast mode to simulate only one sample
          * @param _QUIET        Avoid std::out messages
          * @param _CHECK        Check the correctness of the simulations
+         * @param _SHARD        Work units simulated by this process
          */
-        Simulator(bool _FAST_MODE, bool _QUIET, bool _CHECK) : FAST_MODE(_FAST_MODE), QUIET(_QUIET), CHECK(_CHECK) {}
+        Simulator(uint8_t _N_THREADS, bool _FAST_MODE, bool _QUIET, bool _CHECK, const sys::Shard &_SHARD) :
+                N_THREADS(_N_THREADS), FAST_MODE(_FAST_MODE), QUIET(_QUIET), CHECK(_CHECK), SHARD(_SHARD) {}
 
         /** Simulate architecture for the given network
-        * @param network   Network we want to calculate work reduction
-        * @param control
-        */
-        void run(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control);
+         * The layers of every sample are distributed among the threads, each thread simulates with its own control
+         * stack (dataflow, memories and architecture), and writes the statistics to its own layer and sample slots.
+         * Only the layers and samples of the shard are simulated, sharded runs dump them as partial results.
+         * @param network   Network we want to simulate
+         * @param controls  One independent control stack per thread (the first one names the outputs)
+         */
+        void run(const base::Network<T> &network, const std::vector<std::shared_ptr<Control<T>>> &controls);
 
         /** Calculate potentials for the given network
+         * Only the layers and samples of the shard are calculated, sharded runs dump them as partial results.
          * @param network   Network we want to calculate work reduction
          * @param arch      Pointer to the architecture to simulate
          */
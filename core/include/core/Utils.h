@@ -5,29 +5,479 @@
 
 namespace core {
 
-    typedef std::vector<std::vector<std::vector<double>>> OutputTensor;
+    /**
+     * Output values of a layer stored contiguously, with the windows of every filter one after the other
+     */
+    class OutputTensor {
+    private:
+
+        /** Number of filters */
+        uint64_t filters = 0;
+
+        /** Number of windows in the X dimension */
+        uint64_t Ox = 0;
+
+        /** Number of windows in the Y dimension */
+        uint64_t Oy = 0;
+
+        /** Values in filter, X and Y order */
+        std::vector<double> values;
+
+    public:
+
+        /** Constructor */
+        OutputTensor() = default;
+
+        /**
+         * Constructor, the values start at zero
+         * @param _filters Number of filters
+         * @param _Ox Number of windows in the X dimension
+         * @param _Oy Number of windows in the Y dimension
+         */
+        OutputTensor(uint64_t _filters, uint64_t _Ox, uint64_t _Oy) : filters(_filters), Ox(_Ox), Oy(_Oy),
+                values(_filters * _Ox * _Oy, 0) {}
+
+        double &operator()(uint64_t filter, uint64_t x, uint64_t y) {
+            return values[(filter * Ox + x) * Oy + y];
+        }
+
+        double operator()(uint64_t filter, uint64_t x, uint64_t y) const {
+            return values[(filter * Ox + x) * Oy + y];
+        }
+
+        /**
+         * Return the windows of a filter
+         * @param filter Filter
+         * @return Pointer to the Ox * Oy values of the filter
+         */
+        double *filter_values(uint64_t filter) {
+            return values.data() + filter * Ox * Oy;
+        }
+
+        const std::vector<double> &getValues() const {
+            return values;
+        }
+
+    };
 
     typedef std::tuple<uint16_t, uint16_t> ValueIndex;
 
+    /**
+     * Read-only view of contiguous values owned by a dataflow buffer
+     * The view can share the ownership of the buffer, so it stays valid when the dataflow replaces the buffer
+     * @tparam V Data type of the values
+     */
+    template <typename V>
+    class Span {
+    private:
+
+        /** Owner of the values, null if the values live as long as the layer */
+        std::shared_ptr<const void> owner;
+
+        /** First value */
+        const V *first = nullptr;
+
+        /** Number of values */
+        uint64_t count = 0;
+
+    public:
+
+        /** Constructor */
+        Span() = default;
+
+        /**
+         * Constructor
+         * @param _owner Owner of the values, null if the values live as long as the layer
+         * @param _first First value
+         * @param _count Number of values
+         */
+        Span(std::shared_ptr<const void> _owner, const V *_first, uint64_t _count) : owner(std::move(_owner)),
+                first(_first), count(_count) {}
+
+        /**
+         * Constructor for values that live as long as the layer
+         * @param values Values
+         */
+        explicit Span(const std::vector<V> &values) : first(values.data()), count(values.size()) {}
+
+        /**
+         * Constructor for a range of a shared buffer
+         * @param buffer Buffer with the values
+         * @param _first First index, not greater than the last one
+         * @param _last Index after the last value, not greater than the size of the buffer
+         */
+        Span(const std::shared_ptr<const std::vector<V>> &buffer, uint64_t _first, uint64_t _last) : owner(buffer),
+                first(buffer->data() + _first), count(_last - _first) {
+            assert(_first <= _last && _last <= buffer->size());
+        }
+
+        const V &operator[](uint64_t idx) const {
+            return first[idx];
+        }
+
+        const V &front() const {
+            return first[0];
+        }
+
+        const V *begin() const {
+            return first;
+        }
+
+        const V *end() const {
+            return first + count;
+        }
+
+        uint64_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+    };
+
+    /**
+     * Read-only view of one row of a buffer set, stored as structure of arrays
+     * @tparam T Data type values
+     */
     template <typename T>
-    using ValueTuple = std::tuple<T, uint16_t, uint16_t>;
+    class BufferRow {
+    public:
+
+        /** Values of the row */
+        const T *values = nullptr;
+
+        /** Original time of every value (for Tactical) */
+        const uint16_t *times = nullptr;
+
+        /** Original lane of every value (for Tactical) */
+        const uint16_t *lanes = nullptr;
+
+        /** Number of values in the row */
+        uint64_t width = 0;
+
+        /** Constructor */
+        BufferRow() = default;
+
+        /**
+         * Constructor
+         * @param _values Values of the row
+         * @param _times Original time of every value
+         * @param _lanes Original lane of every value
+         * @param _width Number of values in the row
+         */
+        BufferRow(const T *_values, const uint16_t *_times, const uint16_t *_lanes, uint64_t _width) :
+                values(_values), times(_times), lanes(_lanes), width(_width) {}
+
+        /**
+         * Check if the row has no values
+         * @return True if empty
+         */
+        bool empty() const {
+            return width == 0;
+        }
+
+    };
 
+    /**
+     * Rows of values scheduled in time for the tiles, stored as structure of arrays
+     * All the rows have the same width, and are contiguous in the values, times and lanes arrays
+     * @tparam T Data type values
+     */
     template <typename T>
-    using BufferRow = std::vector<ValueTuple<T>>;
+    class BufferSet {
+    public:
+
+        /** Number of rows */
+        uint64_t rows = 0;
+
+        /** Number of values per row */
+        uint64_t width = 0;
+
+        /** Values of all the rows */
+        std::vector<T> values;
+
+        /** Original time of every value (for Tactical) */
+        std::vector<uint16_t> times;
 
+        /** Original lane of every value (for Tactical) */
+        std::vector<uint16_t> lanes;
+
+        /** Constructor */
+        BufferSet() = default;
+
+        /**
+         * Constructor
+         * @param _rows Number of rows
+         * @param _width Number of values per row, initialised to zero
+         */
+        BufferSet(uint64_t _rows, uint64_t _width) : rows(_rows), width(_width), values(_rows * _width, 0),
+                times(_rows * _width, 0), lanes(_rows * _width, 0) {}
+
+        /**
+         * Change the dimensions, reusing the memory of the values
+         * @param _rows Number of rows
+         * @param _width Number of values per row, initialised to zero
+         */
+        void assign(uint64_t _rows, uint64_t _width) {
+            rows = _rows;
+            width = _width;
+            values.assign(_rows * _width, 0);
+            times.assign(_rows * _width, 0);
+            lanes.assign(_rows * _width, 0);
+        }
+
+        /**
+         * Return the values of one row
+         * @param time Row index
+         * @return Pointer to the first value of the row
+         */
+        const T *row_values(uint64_t time) const {
+            return values.data() + time * width;
+        }
+
+        /**
+         * Return one value
+         * @param time Row index
+         * @param idx Value index in the row
+         * @return Value
+         */
+        T value(uint64_t time, uint64_t idx) const {
+            return values[time * width + idx];
+        }
+
+        /**
+         * Set one value with its original position
+         * @param time Row index
+         * @param idx Value index in the row
+         * @param value Value
+         * @param value_time Original time of the value
+         * @param value_lane Original lane of the value
+         */
+        void set(uint64_t time, uint64_t idx, T value, uint16_t value_time, uint16_t value_lane) {
+            auto pos = time * width + idx;
+            values[pos] = value;
+            times[pos] = value_time;
+            lanes[pos] = value_lane;
+        }
+
+        /**
+         * Swap two values with their original positions
+         * @param time_a Row index of the first value
+         * @param idx_a Index in the row of the first value
+         * @param time_b Row index of the second value
+         * @param idx_b Index in the row of the second value
+         */
+        void swap(uint64_t time_a, uint64_t idx_a, uint64_t time_b, uint64_t idx_b) {
+            auto pos_a = time_a * width + idx_a;
+            auto pos_b = time_b * width + idx_b;
+            std::swap(values[pos_a], values[pos_b]);
+            std::swap(times[pos_a], times[pos_b]);
+            std::swap(lanes[pos_a], lanes[pos_b]);
+        }
+
+        /**
+         * Return a view of one row, valid while the buffer set is not modified
+         * @param time Row index
+         * @return Row
+         */
+        BufferRow<T> row(uint64_t time) const {
+            auto first = time * width;
+            return BufferRow<T>(values.data() + first, times.data() + first, lanes.data() + first, width);
+        }
+
+        /**
+         * Check if the set has no rows
+         * @return True if empty
+         */
+        bool empty() const {
+            return rows == 0;
+        }
+
+    };
+
+    /**
+     * Read-only view of a range of rows of a buffer set, sharing the ownership of the buffer set
+     * @tparam T Data type values
+     */
     template <typename T>
-    using BufferSet = std::vector<std::vector<ValueTuple<T>>>;
+    class BufferSlice {
+    private:
+
+        /** Buffer set with the rows */
+        std::shared_ptr<const BufferSet<T>> buffer;
+
+        /** First row of the slice in the buffer set */
+        uint64_t first = 0;
+
+    public:
+
+        /** Number of rows */
+        uint64_t rows = 0;
+
+        /** Constructor */
+        BufferSlice() = default;
+
+        /**
+         * Constructor
+         * @param _buffer Buffer set with the rows
+         * @param _first First row index
+         * @param _last Row index after the last row, clipped to the number of rows
+         */
+        BufferSlice(std::shared_ptr<const BufferSet<T>> _buffer, uint64_t _first, uint64_t _last) :
+                buffer(std::move(_buffer)), first(_first), rows(std::min(_last, buffer->rows) - _first) {}
+
+        /**
+         * Return the values of one row
+         * @param time Row index in the slice
+         * @return Pointer to the first value of the row
+         */
+        const T *row_values(uint64_t time) const {
+            return buffer->row_values(first + time);
+        }
+
+        /**
+         * Return one value
+         * @param time Row index in the slice
+         * @param idx Value index in the row
+         * @return Value
+         */
+        T value(uint64_t time, uint64_t idx) const {
+            return buffer->value(first + time, idx);
+        }
+
+        /**
+         * Check if the slice has no rows
+         * @return True if empty
+         */
+        bool empty() const {
+            return rows == 0;
+        }
+
+    };
 
     template <typename T>
-    using Buffer = std::vector<std::vector<std::vector<ValueTuple<T>>>>;
+    using Buffer = std::vector<BufferSet<T>>;
 
     typedef std::tuple<int, int> WindowCoord;
 
     typedef std::tuple<uint64_t, uint64_t> AddressRange;
 
-    typedef std::vector<std::vector<std::vector<uint64_t>>> AddressMap;
+    /**
+     * Addresses of the activations, stored channel-first, then row and column
+     * Every position holds consecutive blocks of channels, so the address is computed from the coordinates
+     */
+    class AddressMap {
+    private:
+
+        /** Address of the first block */
+        uint64_t first_address = 0;
+
+        /** Number of positions in the X dimension */
+        uint64_t Nx = 0;
+
+        /** Number of channel blocks of a position */
+        uint64_t channel_blks = 0;
+
+        /** Bytes of a block */
+        uint64_t width = 0;
+
+    public:
+
+        /** Constructor */
+        AddressMap() = default;
+
+        /**
+         * Constructor
+         * @param _first_address Address of the first block
+         * @param _Nx Number of positions in the X dimension
+         * @param _channel_blks Number of channel blocks of a position
+         * @param _width Bytes of a block
+         */
+        AddressMap(uint64_t _first_address, uint64_t _Nx, uint64_t _channel_blks, uint64_t _width) :
+                first_address(_first_address), Nx(_Nx), channel_blks(_channel_blks), width(_width) {}
+
+        /**
+         * Return the index of a block of channels, consecutive indices are consecutive addresses
+         * @param y Y coordinate
+         * @param x X coordinate
+         * @param blk Channel block
+         * @return Index of the block
+         */
+        uint64_t block(uint64_t y, uint64_t x, uint64_t blk) const {
+            return (y * Nx + x) * channel_blks + blk;
+        }
+
+        /**
+         * Return the address of a block index
+         * @param block Index of the block
+         * @return Address of the block
+         */
+        uint64_t address(uint64_t block) const {
+            return first_address + block * width;
+        }
+
+        /**
+         * Return the address of a block of channels
+         * @param y Y coordinate
+         * @param x X coordinate
+         * @param blk Channel block
+         * @return Address of the block
+         */
+        uint64_t operator()(uint64_t y, uint64_t x, uint64_t blk) const {
+            return address(block(y, x, blk));
+        }
+
+    };
+
+    /**
+     * Banks of the activations, assigned round-robin to the positions
+     * The rows that start a window continue the banks where the first window of the previous one ended, the rest
+     * continue the banks of the previous row
+     */
+    class ActBankMap {
+    private:
+
+        /** Number of positions in the X dimension */
+        uint64_t Nx = 0;
+
+        /** Banks skipped between the rows that start a window */
+        uint64_t window_banks = 0;
+
+        /** Stride of the layer */
+        uint64_t stride = 1;
+
+        /** Number of banks */
+        uint64_t banks = 1;
+
+    public:
+
+        /** Constructor */
+        ActBankMap() = default;
+
+        /**
+         * Constructor
+         * @param _Nx Number of positions in the X dimension
+         * @param _window_banks Banks skipped between the rows that start a window
+         * @param _stride Stride of the layer
+         * @param _banks Number of banks
+         */
+        ActBankMap(uint64_t _Nx, uint64_t _window_banks, uint64_t _stride, uint64_t _banks) : Nx(_Nx),
+                window_banks(_window_banks), stride(_stride), banks(_banks) {}
+
+        /**
+         * Return the bank of a position
+         * @param y Y coordinate
+         * @param x X coordinate
+         * @return Bank
+         */
+        int operator()(uint64_t y, uint64_t x) const {
+            auto row_bank = (y / stride) * window_banks + (y % stride) * Nx;
+            return (int)((row_bank + x) % banks);
+        }
 
-    typedef std::vector<std::vector<int>> ActBankMap;
+    };
 
     typedef std::vector<std::vector<std::vector<uint64_t>>> AddressBuffer;
 
@@ -41,8 +491,103 @@ namespace core {
 
     typedef std::vector<int> BankBufferRow;
 
+    /**
+     * Row of addresses that are consecutive blocks in memory, expanded when read
+     */
+    class StridedAddressRow {
+    private:
+
+        /** First address */
+        uint64_t first = 0;
+
+        /** Number of addresses */
+        uint64_t count = 0;
+
+        /** Distance between two addresses, zero repeats the first one (rows of not valid addresses) */
+        uint64_t step = 0;
+
+    public:
+
+        /** Constructor */
+        StridedAddressRow() = default;
+
+        /**
+         * Constructor
+         * @param _first First address
+         * @param _count Number of addresses
+         * @param _step Distance between two addresses, zero repeats the first one
+         */
+        StridedAddressRow(uint64_t _first, uint64_t _count, uint64_t _step) : first(_first), count(_count),
+                step(_step) {}
+
+        uint64_t operator[](uint64_t idx) const {
+            return first + idx * step;
+        }
+
+        uint64_t front() const {
+            return first;
+        }
+
+        uint64_t back() const {
+            return first + (count - 1) * step;
+        }
+
+        uint64_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+    };
+
+    /**
+     * Row of banks assigned round-robin, expanded when read
+     */
+    class RoundRobinBankRow {
+    private:
+
+        /** First bank */
+        uint64_t first = 0;
+
+        /** Number of banks in the row */
+        uint64_t count = 0;
+
+        /** Total number of banks */
+        uint64_t banks = 1;
+
+    public:
+
+        /** Constructor */
+        RoundRobinBankRow() = default;
+
+        /**
+         * Constructor
+         * @param _first First bank
+         * @param _count Number of banks in the row
+         * @param _banks Total number of banks
+         */
+        RoundRobinBankRow(uint64_t _first, uint64_t _count, uint64_t _banks) : first(_first), count(_count),
+                banks(_banks) {}
+
+        int operator[](uint64_t idx) const {
+            return (int)((first + idx) % banks);
+        }
+
+        uint64_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+    };
+
     /**
      * Data to process per tile
+     * The inputs are views of the buffers of the dataflow, only the output addresses are owned by the tile
      * @tparam T Data type values
      */
     template <typename T>
@@ -50,22 +595,22 @@ namespace core {
     public:
 
         /** 2D Input activations (2D because of Tactical) */
-        BufferSet<T> act_row;
+        BufferSlice<T> act_row;
 
         /** 1D Input weights */
         BufferRow<T> wgt_row;
 
         /** Window indices to process */
-        std::vector<WindowCoord> windows;
+        Span<WindowCoord> windows;
 
         /** Filter indices to process */
-        std::vector<int> filters;
+        Span<int> filters;
 
         /** 2D Input activation mapped addresses */
-        AddressBufferSet act_addresses;
+        Span<AddressBufferRow> act_addresses;
 
         /** 1D Weights mapped addresses */
-        AddressBufferRow wgt_addresses;
+        StridedAddressRow wgt_addresses;
 
         /** 1D Partial sum mapped addresses */
         AddressBufferRow psum_addresses;
@@ -74,13 +619,13 @@ namespace core {
         AddressBufferRow out_addresses;
 
         /** 2D Input activation mapped on-chip banks */
-        BankBufferSet act_banks;
+        Span<BankBufferRow> act_banks;
 
         /** 1D Partial sum mapped on-chip banks */
         BankBufferRow psum_banks;
 
         /** 1D Weight mapped on-chip banks */
-        BankBufferRow wgt_banks;
+        RoundRobinBankRow wgt_banks;
 
         /** 1D Output activation mapped on-chip banks */
         BankBufferRow out_banks;
@@ -93,6 +638,25 @@ namespace core {
 
         /** Valida data flag */
         bool valid = false;
+
+        /** Clear the data to fill the tile again, keeping the memory of the output addresses */
+        void reset() {
+            act_row = BufferSlice<T>();
+            wgt_row = BufferRow<T>();
+            windows = Span<WindowCoord>();
+            filters = Span<int>();
+            act_addresses = Span<AddressBufferRow>();
+            wgt_addresses = StridedAddressRow();
+            psum_addresses.clear();
+            out_addresses.clear();
+            act_banks = Span<BankBufferRow>();
+            psum_banks.clear();
+            wgt_banks = RoundRobinBankRow();
+            out_banks.clear();
+            time = 0;
+            lanes = 0;
+            valid = false;
+        }
     };
 
     /**
@@ -122,6 +686,14 @@ namespace core {
         explicit TilesData(uint64_t _tiles) {
             data = std::vector<TileData<T>>(_tiles, TileData<T>());
         }
+
+        /** Clear the data of all the tiles to fill them again */
+        void reset() {
+            for (auto &tile_data : data) tile_data.reset();
+            read_act = false;
+            read_psum = false;
+            read_wgt = false;
+        }
     };
 
     /**
@@ -14,6 +14,65 @@ namespace core {
 
     private:
 
+        /** Output stationary node */
+        typedef typename OutputStationary<T>::NodeOutS NodeOutS;
+
+        /** Memory stages of the execution graph of the layer, and position of the next node to generate */
+        class ExecutionGraph {
+        public:
+
+            /** Activations on-chip memory policy */
+            MemPolicy act_policy = ALL;
+
+            /** Weights on-chip memory policy */
+            MemPolicy wgt_policy = ALL;
+
+            /** Window sets of every window step */
+            std::vector<std::vector<int>> window_steps;
+
+            /** Number of groups per group step */
+            uint32_t groups_per_step = 0;
+
+            /** Number of filter sets per group */
+            uint32_t filter_sets_per_group = 0;
+
+            /** Number of filter steps */
+            uint32_t filter_steps = 0;
+
+            /** Number of filter sets per filter step */
+            uint32_t filter_sets_per_step = 0;
+
+            /** Total number of filter sets */
+            uint32_t total_filter_sets = 0;
+
+            /** Number of time steps */
+            uint32_t time_steps = 0;
+
+            /** Maximum buffer time per time step */
+            uint32_t max_time_per_step = 0;
+
+            /** Number of activation blocks per position */
+            uint32_t last_act_blk = 0;
+
+            /** Number of activation blocks per window */
+            uint32_t blks_per_window = 0;
+
+            /** Number of nodes */
+            uint64_t nodes = 0;
+
+            /** Index of the next node */
+            uint64_t next_node = 0;
+
+            /** True if the next node evicts the previous outputs */
+            bool next_evict_out = false;
+
+            /** Next output address to write */
+            uint64_t next_out_address = 0;
+        };
+
+        /** Execution graph of the current layer */
+        ExecutionGraph graph;
+
         /**
          * Return name for the dataflow
          * @return Name of the dataflow
@@ -25,21 +84,45 @@ namespace core {
          */
         void generate_execution_graph_conv_layer();
 
+        /**
+         * Generate the node of the next on-chip stage for convolutional layers
+         * @param node Empty node (Overwritten)
+         */
+        void generate_node_conv_layer(const std::shared_ptr<NodeOutS> &node);
+
         /**
          * Generate execution graph for grouped layers
          */
         void generate_execution_graph_grouped_layer();
 
+        /**
+         * Generate the node of the next on-chip stage for grouped layers
+         * @param node Empty node (Overwritten)
+         */
+        void generate_node_grouped_layer(const std::shared_ptr<NodeOutS> &node);
+
         /**
          * Generate execution graph for linear layers
          */
         void generate_execution_graph_linear_layer();
 
         /**
-         * Generate execution graph
+         * Generate the node of the next on-chip stage for linear layers
+         * @param node Empty node (Overwritten)
+         */
+        void generate_node_linear_layer(const std::shared_ptr<NodeOutS> &node);
+
+        /**
+         * Generate execution graph, up to the node of the first on-chip stage
          */
         void generate_execution_graph() override;
 
+        /**
+         * Generate the node of the next on-chip stage of the execution graph
+         * @return False if no more on-chip stages
+         */
+        bool generate_next_node() override;
+
         /**
          * Configure control values for the current layer
          * @param _act      Pointer to activation values
@@ -94,6 +177,23 @@ namespace core {
                 const std::shared_ptr<PPU<T>> &_ppu) : OutputStationary<T>(_scheduler, _dram, _gbuffer, _abuffer,
                 _pbuffer, _wbuffer, _obuffer, _composer, _ppu) {}
 
+        /**
+         * Return the state carried to the next layer from the shapes of the current one, including if the execution
+         * graph keeps the activations on-chip
+         * @param state     State left by the previous layer
+         * @param act_shape Activations shape of one sample
+         * @param wgt_shape Weights shape
+         * @param act_prec  Activations precision
+         * @param wgt_prec  Weight precision
+         * @param _linear   True if linear layer
+         * @param __3dim    True if layer has 3 dimensions
+         * @param _stride   Stride
+         * @return State for the next layer
+         */
+        typename Control<T>::LayerState next_layer_state(const typename Control<T>::LayerState &state,
+                const std::vector<size_t> &act_shape, const std::vector<size_t> &wgt_shape, uint32_t act_prec,
+                uint32_t wgt_prec, bool _linear, bool __3dim, int _stride) const override;
+
     };
 
 }
@@ -0,0 +1,106 @@
+
+#include <core/AddressTable.h>
+
+namespace core {
+
+    const uint32_t AddressTable::NOT_TRACKED;
+
+    AddressTable::AddressTable(uint64_t START_ACT_ADDRESS, uint64_t START_WGT_ADDRESS, uint64_t _WIDTH) :
+            WIDTH(_WIDTH) {
+        regions.emplace_back(std::max(START_ACT_ADDRESS, START_WGT_ADDRESS));
+        if (START_ACT_ADDRESS != START_WGT_ADDRESS)
+            regions.emplace_back(std::min(START_ACT_ADDRESS, START_WGT_ADDRESS));
+    }
+
+    uint32_t &AddressTable::add_block(Region &region, uint64_t blk) {
+        auto &levels = region.levels;
+
+        if (levels.empty()) {
+            region.first_blk = blk;
+            levels.push_back(NOT_TRACKED);
+        } else if (blk < region.first_blk) {
+            // Leave room for the previous blocks as well
+            auto extra = std::min(std::max(region.first_blk - blk, (uint64_t)levels.size()), region.first_blk);
+            levels.insert(levels.begin(), extra, NOT_TRACKED);
+            region.first_blk -= extra;
+        } else if (blk - region.first_blk >= levels.size()) {
+            auto size = std::max(blk - region.first_blk + 1, 2 * (uint64_t)levels.size());
+            levels.resize(size, NOT_TRACKED);
+        }
+
+        return levels[blk - region.first_blk];
+    }
+
+    void AddressTable::insert(uint64_t addr, uint32_t level) {
+        uint64_t blk = 0;
+        auto r = find_region(addr, blk);
+        if (r < 0) {
+            if (others.insert({addr, level}).second)
+                count++;
+            return;
+        }
+
+        auto &blk_level = add_block(regions[r], blk);
+        if (blk_level == NOT_TRACKED) {
+            blk_level = level;
+            count++;
+        }
+    }
+
+    void AddressTable::erase(uint64_t addr) {
+        uint64_t blk = 0;
+        auto r = find_region(addr, blk);
+        if (r < 0) {
+            count -= others.erase(addr);
+        } else if (tracked_block(regions[r], blk)) {
+            regions[r].levels[blk - regions[r].first_blk] = NOT_TRACKED;
+            count--;
+        }
+    }
+
+    void AddressTable::erase(uint64_t min_addr, uint64_t max_addr) {
+        if (!contains(min_addr)) {
+            erase(max_addr);
+            return;
+        }
+
+        erase_range(min_addr, contains(max_addr) ? max_addr : UINT64_MAX);
+    }
+
+    void AddressTable::erase_range(uint64_t min_addr, uint64_t max_addr) {
+        if (min_addr > max_addr)
+            return;
+
+        for (auto &region : regions) {
+            if (region.levels.empty() || max_addr < region.start)
+                continue;
+
+            // Blocks of the region inside the range
+            auto first_blk = min_addr <= region.start ? 0 : (min_addr - region.start + WIDTH - 1) / WIDTH;
+            auto last_blk = (max_addr - region.start) / WIDTH;
+
+            first_blk = std::max(first_blk, region.first_blk);
+            last_blk = std::min(last_blk, region.first_blk + region.levels.size() - 1);
+            if (first_blk > last_blk)
+                continue;
+
+            auto first = region.levels.begin() + (first_blk - region.first_blk);
+            auto last = region.levels.begin() + (last_blk - region.first_blk) + 1;
+            count -= std::count_if(first, last, [](uint32_t level) { return level != NOT_TRACKED; });
+            std::fill(first, last, NOT_TRACKED);
+        }
+
+        auto first = others.lower_bound(min_addr);
+        auto last = others.upper_bound(max_addr);
+        count -= std::distance(first, last);
+        others.erase(first, last);
+    }
+
+    void AddressTable::clear() {
+        for (auto &region : regions)
+            region.levels.clear();
+        others.clear();
+        count = 0;
+    }
+
+}
@@ -68,7 +68,7 @@ namespace core {
     }
 
     template <typename T>
-    uint16_t BitPragmatic<T>::process_pe(const BufferSet<T> &act_row, const BufferRow<T> &wgt_row, int window_idx,
+    uint16_t BitPragmatic<T>::process_pe(const BufferSlice<T> &act_row, const BufferRow<T> &wgt_row, int window_idx,
             int filter_idx, int lanes, int time, int act_blk) {
 
         auto shift = this->PE_WIDTH * act_blk;
@@ -80,13 +80,13 @@ namespace core {
             auto time_h = 0;
             auto lane_d = lane;
             if (!wgt_row.empty()) {
-                time_h = std::get<1>(wgt_row[filter_idx + lane]) - time;
-                lane_d = std::get<2>(wgt_row[filter_idx + lane]);
+                time_h = wgt_row.times[filter_idx + lane] - time;
+                lane_d = wgt_row.lanes[filter_idx + lane];
 
                 if (time_h < 0) continue;
             }
 
-            auto act_bits = std::get<0>(act_row[time_h][window_idx + lane_d]);
+            auto act_bits = act_row.value(time_h, window_idx + lane_d);
             if (DIFFY) act_bits = abs((short)act_bits);
             act_bits = (act_bits & mask) >> shift;
 
@@ -134,11 +134,11 @@ namespace core {
 
 
     template <typename T>
-    void BitPragmatic<T>::process_linear(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void BitPragmatic<T>::process_linear(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -194,12 +194,12 @@ namespace core {
     }
 
     template <typename T>
-    void BitPragmatic<T>::process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void BitPragmatic<T>::process_mmul(const TilesData<T> &tiles_data) {
 
         auto max_column_cycles = std::vector<uint64_t>(this->column_cycles.size(), 0);
 
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -275,7 +275,7 @@ namespace core {
     }
 
     template <typename T>
-    void BitPragmatic<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void BitPragmatic<T>::process_tiles(const TilesData<T> &tiles_data) {
         if (this->linear) process_linear(tiles_data);
         else process_mmul(tiles_data);
     }
@@ -304,6 +304,14 @@ namespace core {
         return effectualBits(act_bits) * this->network_width;
     }
 
+    template <typename T>
+    uint64_t BitPragmatic<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t bits = 0;
+        for (uint64_t i = 0; i < size; ++i)
+            bits += BitPragmatic<T>::computeBits(act[i], wgt[i]);
+        return bits;
+    }
+
     template class BitPragmatic<uint16_t>;
 
 }
\ No newline at end of file
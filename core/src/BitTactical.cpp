@@ -16,10 +16,10 @@ namespace core {
     }
 
     template <typename T>
-    bool BitTactical<T>::check_zero_line(const BufferRow<T> &buffer) {
-        for(auto tuple : buffer) {
-            auto value = std::get<0>(tuple);
-            if(value != 0) return false;
+    bool BitTactical<T>::check_zero_line(const BufferSet<T> &buffer, uint64_t time) {
+        const T *values = buffer.row_values(time);
+        for (int lane = 0; lane < buffer.width; ++lane) {
+            if(values[lane] != 0) return false;
         }
         return true;
     }
@@ -36,9 +36,7 @@ namespace core {
         auto cand_lane = std::get<1>(candidate);
 
         // Swap
-        auto ineffectual_tuple = buffer[inef_time][inef_lane];
-        buffer[inef_time][inef_lane] = buffer[cand_time][cand_lane];
-        buffer[cand_time][cand_lane] = ineffectual_tuple;
+        buffer.swap(inef_time, inef_lane, cand_time, cand_lane);
     }
 
     template <typename T>
@@ -62,8 +60,7 @@ namespace core {
             if(time_h >= max_time) continue;
             lane_d = (lane_d) < upper_bound ? LANES + lane_d : lane_d; // Wrap around
             lane_d = (lane_d) >= lower_bound ? lane_d - LANES : lane_d; // Wrap around
-            auto value_tuple = buffer[time_h][lane_d];
-            auto value_bits = std::get<0>(value_tuple);
+            auto value_bits = buffer.value(time_h, lane_d);
             if(value_bits != 0) effectual_candidates.push_back({time_h, lane_d});
         }
 
@@ -71,72 +68,89 @@ namespace core {
     }
 
     template <typename T>
-    void BitTactical<T>::original_schedule(BufferSet<T> &buffer) {
-
-        auto max_time = buffer.size();
-        auto groups = buffer.front().size() / LANES;
-
-        int skip = 0;
-        for (int time = 0; time < max_time; ++time) {
-
-            // Skip lines of zeroes
-            if (skip < LOOKAHEAD_H && check_zero_line(buffer[time])) {
-                skip++;
-                continue;
-            }
-            skip = 0;
-
-            for (int group = 0; group < groups; ++group) {
-
-                int overlap = 1;
-                while(overlap > 0) {
-
-                    // Get ineffectual values
-                    int init_lane = group * LANES;
-                    std::vector<ValueIndex> ineffectual_values;
-                    for(int lane = init_lane; lane < init_lane + LANES; lane++) {
-                        auto value_tuple = buffer[time][lane];
-                        auto value_bits = std::get<0>(value_tuple);
-                        if(value_bits == 0) ineffectual_values.emplace_back(std::make_tuple(time, lane));
-                    }
-
-                    // Num of candidates for each ineffectual values
-                    overlap = -1;
-                    std::vector<uint16_t> num_candidates (LANES, 0);
-                    std::vector<std::vector<ValueIndex>> effectual_candidates (LANES, std::vector<ValueIndex>());
-                    for(auto inef_idx : ineffectual_values) {
-                        auto lane = std::get<1>(inef_idx);
-                        effectual_candidates[lane % LANES] = search(buffer, inef_idx, max_time);
-                        if(!effectual_candidates[lane % LANES].empty()) {
-                            auto effectual_num_candidates = (uint16_t)effectual_candidates[lane % LANES].size();
-                            num_candidates[lane % LANES] = effectual_num_candidates;
-                            if (effectual_num_candidates > overlap) overlap = effectual_num_candidates;
+    void BitTactical<T>::original_schedule(BufferSet<T> &buffer, int threads) {
+
+        int max_time = buffer.rows;
+        int groups = buffer.width / LANES;
+
+        #pragma omp parallel num_threads(threads) if(threads > 1 && groups > 1)
+        {
+            // Every thread takes the same skipping decisions
+            int skip = 0;
+            for (int time = 0; time < max_time; ++time) {
+
+                // Skip lines of zeroes
+                bool zero_line = skip < LOOKAHEAD_H && check_zero_line(buffer, time);
+
+                // No group promotes into the line until every thread has checked it
+                #pragma omp barrier
+
+                if (zero_line) {
+                    skip++;
+                    continue;
+                }
+                skip = 0;
+
+                #pragma omp for schedule(static)
+                for (int group = 0; group < groups; ++group) {
+
+                    int overlap = 1;
+                    while(overlap > 0) {
+
+                        // Get ineffectual values
+                        int init_lane = group * LANES;
+                        std::vector<ValueIndex> ineffectual_values;
+                        const T *values = buffer.row_values(time);
+                        for(int lane = init_lane; lane < init_lane + LANES; lane++) {
+                            if(values[lane] == 0) ineffectual_values.emplace_back(std::make_tuple(time, lane));
                         }
-                    }
-
-                    // Promote less flexible candidates first
-                    for(auto inef_idx : ineffectual_values) {
-                        auto lane = std::get<1>(inef_idx);
-                        if(num_candidates[lane % LANES] == overlap) {
-                            //Promote value
-                            auto cand_idx = effectual_candidates[lane % LANES].front();
-                            promote(buffer, inef_idx, cand_idx);
-                            break;
+
+                        // Num of candidates for each ineffectual values
+                        overlap = -1;
+                        std::vector<uint16_t> num_candidates (LANES, 0);
+                        std::vector<std::vector<ValueIndex>> effectual_candidates (LANES,
+                                std::vector<ValueIndex>());
+                        for(auto inef_idx : ineffectual_values) {
+                            auto lane = std::get<1>(inef_idx);
+                            effectual_candidates[lane % LANES] = search(buffer, inef_idx, max_time);
+                            if(!effectual_candidates[lane % LANES].empty()) {
+                                auto effectual_num_candidates = (uint16_t)effectual_candidates[lane % LANES].size();
+                                num_candidates[lane % LANES] = effectual_num_candidates;
+                                if (effectual_num_candidates > overlap) overlap = effectual_num_candidates;
+                            }
                         }
-                    }
 
-                } // Optimal promotion loop
+                        // Promote less flexible candidates first
+                        for(auto inef_idx : ineffectual_values) {
+                            auto lane = std::get<1>(inef_idx);
+                            if(num_candidates[lane % LANES] == overlap) {
+                                //Promote value
+                                auto cand_idx = effectual_candidates[lane % LANES].front();
+                                promote(buffer, inef_idx, cand_idx);
+                                break;
+                            }
+                        }
 
-            } // Group
-        } // Time
+                    } // Optimal promotion loop
+
+                } // Group
+            } // Time
+        }
 
     }
 
     template <typename T>
     void BitTactical<T>::schedule(Buffer<T> &buffer, uint32_t _LANES) {
         LANES = _LANES;
-        for (auto &buffer_set : buffer) {
-            original_schedule(buffer_set);
+
+        // Fewer buffer sets than threads: schedule the groups of lanes of every set in parallel instead
+        int sets = buffer.size();
+        int set_threads = sets >= N_THREADS ? N_THREADS : 1;
+        int group_threads = sets >= N_THREADS ? 1 : N_THREADS;
+
+        #pragma omp parallel for num_threads(set_threads) if(set_threads > 1) schedule(dynamic)
+        for (int set = 0; set < sets; ++set) {
+            original_schedule(buffer[set], group_threads);
         }
     }
 
@@ -65,6 +65,32 @@ namespace core {
         arch->setGlobalCycle(global_cycle);
     }
 
+    template <typename T>
+    typename Control<T>::LayerState Control<T>::getLayerState() const {
+        LayerState state;
+        state.next_layer_act_on_chip = next_layer_act_on_chip;
+        return state;
+    }
+
+    template <typename T>
+    void Control<T>::setLayerState(const LayerState &state) {
+        next_layer_act_on_chip = state.next_layer_act_on_chip;
+    }
+
+    template <typename T>
+    typename Control<T>::LayerState Control<T>::next_layer_state(const LayerState &state,
+            const std::vector<size_t> &act_shape, const std::vector<size_t> &wgt_shape, uint32_t act_prec,
+            uint32_t wgt_prec, bool _linear, bool __3dim, int _stride) const {
+        auto next_state = state;
+        next_state.next_layer_act_on_chip = false;
+        return next_state;
+    }
+
+    template <typename T>
+    uint32_t Control<T>::dram_data_size(uint32_t prec) const {
+        return std::max(dram->getBaseDataSize(), (uint32_t)pow(2, ceil(log2(prec))));
+    }
+
     template <typename T>
     void Control<T>::configure_layer(const std::shared_ptr<base::Array<T>> &_act,
             const std::shared_ptr<base::Array<T>> &_wgt, uint32_t act_prec, uint32_t wgt_prec, bool _linear,
@@ -92,8 +118,8 @@ namespace core {
         if (EF_ROWS == 0)
             throw std::runtime_error ("Too few rows to perform spatial decomposition");
 
-        auto act_dram_width = std::max(dram->getBaseDataSize(), (uint32_t)pow(2, ceil(log2(act_prec))));
-        auto wgt_dram_width = std::max(dram->getBaseDataSize(), (uint32_t)pow(2, ceil(log2(wgt_prec))));
+        auto act_dram_width = dram_data_size(act_prec);
+        auto wgt_dram_width = dram_data_size(wgt_prec);
 
         *global_cycle = 0;
         dram->configure_layer(act_dram_width, wgt_dram_width);
@@ -108,53 +134,52 @@ namespace core {
 
     template <typename T>
     const std::vector<AddressRange> &Control<T>::getReadActAddresses() const {
-        return on_chip_graph.front()->read_act_addresses;
+        return current_node()->read_act_addresses;
     }
 
     template <typename T>
     const std::vector<AddressRange> &Control<T>::getReadPsumAddresses() const {
-        return on_chip_graph.front()->read_psum_addresses;
+        return current_node()->read_psum_addresses;
     }
 
     template <typename T>
     const std::vector<AddressRange> &Control<T>::getReadWgtAddresses() const {
-        return on_chip_graph.front()->read_wgt_addresses;
+        return current_node()->read_wgt_addresses;
     }
 
     template <typename T>
     const std::vector<AddressRange> &Control<T>::getWriteAddresses() const {
-        return on_chip_graph.front()->write_addresses;
+        return current_node()->write_addresses;
     }
 
     template <typename T>
     bool Control<T>::getIfEvictAct() const {
-        return on_chip_graph.front()->evict_act;
+        return current_node()->evict_act;
     }
 
     template <typename T>
     bool Control<T>::getIfEvictOut() const {
-        return on_chip_graph.front()->evict_out;
+        return current_node()->evict_out;
     }
 
     template <typename T>
     bool Control<T>::getIfEvictWgt() const {
-        return on_chip_graph.front()->evict_wgt;
+        return current_node()->evict_wgt;
     }
 
     template <typename T>
     bool Control<T>::getIfLayerActOnChip() const {
-        return on_chip_graph.front()->layer_act_on_chip;
+        return current_node()->layer_act_on_chip;
     }
 
     template <typename T>
     bool Control<T>::still_off_chip_data() {
-        on_chip_graph.erase(on_chip_graph.begin());
-        return !on_chip_graph.empty();
+        return generate_next_node();
     }
 
     template <typename T>
-    bool Control<T>::check_if_write_output(const std::shared_ptr<TilesData<T>> &tiles_data) {
-        for (const auto &tile_data : tiles_data->data)
+    bool Control<T>::check_if_write_output(const TilesData<T> &tiles_data) {
+        for (const auto &tile_data : tiles_data.data)
             if (!tile_data.out_addresses.empty())
                 return true;
         return false;
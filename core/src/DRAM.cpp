@@ -78,6 +78,7 @@ namespace core {
     std::string DRAM<T>::header() {
         std::string header = "Starting activation address: " + addr_to_hex(START_ACT_ADDRESS, SIZE) + "\n";
         header += "Starting weight address: " + addr_to_hex(START_WGT_ADDRESS, SIZE) + "\n";
+        header += "Every layer starts with an idle DRAM\n";
         return header;
     }
 
@@ -95,23 +96,26 @@ namespace core {
         this->tracked_data->clear();
 
         act_reads = 0;
+        psum_reads = 0;
         wgt_reads = 0;
         out_writes = 0;
     }
 
     template <typename T>
     std::vector<AddressRange> DRAM<T>::compress_addresses(const std::vector<uint64_t> &addresses) {
-        auto tmp_addresses = addresses;
-        std::sort(tmp_addresses.begin(), tmp_addresses.end());
-        auto last = std::unique(tmp_addresses.begin(), tmp_addresses.end());
-        tmp_addresses.erase(last, tmp_addresses.end());
+        assert(std::is_sorted(addresses.begin(), addresses.end()));
 
-        uint64_t prev_addr = tmp_addresses.front();
-        auto addr_tuple = std::make_tuple(prev_addr, NULL_ADDR);
         auto compressed_addresses = std::vector<AddressRange>();
+        if (addresses.empty())
+            return compressed_addresses;
+
+        uint64_t prev_addr = addresses.front();
+        auto addr_tuple = std::make_tuple(prev_addr, NULL_ADDR);
 
-        for (int i = 1; i < tmp_addresses.size(); ++i) {
-            const auto &addr = tmp_addresses[i];
+        for (int i = 1; i < addresses.size(); ++i) {
+            const auto &addr = addresses[i];
+            if (addr == prev_addr)
+                continue;
             if (addr - prev_addr - WIDTH != 0) {
                 std::get<1>(addr_tuple) = prev_addr;
                 compressed_addresses.emplace_back(addr_tuple);
@@ -130,6 +134,14 @@ namespace core {
         dram_interface->update();
     }
 
+    template <typename T>
+    void DRAM<T>::reset() {
+        dram_interface->reset();
+        request_queue.clear();
+        request_head = 0;
+        waiting_addresses.clear();
+    }
+
     template <typename T>
     bool DRAM<T>::data_ready() {
         return waiting_addresses.empty();
@@ -147,15 +159,17 @@ namespace core {
                     for (const auto &act_addr_row : tile_data.act_addresses)
                         for (const auto &act_addr : act_addr_row)
                             if (act_addr != NULL_ADDR && (*this->tracked_data).at(act_addr) == 0)
-                                waiting_addresses.insert(act_addr);
+                                waiting_addresses.insert(act_addr, 0);
 
                 for (const auto &psum_addr : tile_data.psum_addresses)
                     if (psum_addr != NULL_ADDR && (*this->tracked_data).at(psum_addr) == 0)
-                        waiting_addresses.insert(psum_addr);
+                        waiting_addresses.insert(psum_addr, 0);
 
-                for (const auto &wgt_addr : tile_data.wgt_addresses)
+                for (int idx = 0; idx < tile_data.wgt_addresses.size(); ++idx) {
+                    auto wgt_addr = tile_data.wgt_addresses[idx];
                     if (wgt_addr != NULL_ADDR && (*this->tracked_data).at(wgt_addr) == 0)
-                        waiting_addresses.insert(wgt_addr);
+                        waiting_addresses.insert(wgt_addr, 0);
+                }
 
             }
         } catch (std::exception &exception) {
@@ -169,7 +183,26 @@ namespace core {
         if (dram_interface->willAcceptTransaction()) {
             dram_interface->addTransaction(isWrite, address);
         } else {
-            request_queue.push({address, isWrite});
+            request_queue.emplace_back(address, isWrite);
+        }
+    }
+
+    template <typename T>
+    void DRAM<T>::issue_queued_request() {
+        if (request_head == request_queue.size())
+            return;
+
+        auto request = request_queue[request_head];
+        transaction_request(std::get<0>(request), std::get<1>(request));
+        request_head++;
+
+        // Drop the issued transactions once the queue drains, or once they are most of it
+        if (request_head == request_queue.size()) {
+            request_queue.clear();
+            request_head = 0;
+        } else if (request_head >= 1024 && 2 * request_head >= request_queue.size()) {
+            request_queue.erase(request_queue.begin(), request_queue.begin() + request_head);
+            request_head = 0;
         }
     }
 
@@ -178,15 +211,8 @@ namespace core {
         try {
             (*this->tracked_data).at(address) = 1;
 
-            auto it = waiting_addresses.find(address);
-            if (it != waiting_addresses.end())
-                waiting_addresses.erase(address);
-
-            if (!request_queue.empty()) {
-                auto tuple = request_queue.front();
-                transaction_request(std::get<0>(tuple), std::get<1>(tuple));
-                request_queue.pop();
-            }
+            waiting_addresses.erase(address);
+            issue_queued_request();
         } catch (std::exception &exception) {
             throw std::runtime_error("DRAM waiting for a memory address not requested.");
         }
@@ -245,7 +271,7 @@ namespace core {
                     if (count == OVERLAP)
                         break;
 
-                    this->tracked_data->insert({act_start_addr, 0});
+                    this->tracked_data->insert(act_start_addr, 0);
                     transaction_request(act_start_addr, false);
                     still_data = true;
                     act_reads++;
@@ -288,7 +314,7 @@ namespace core {
                     if (count == OVERLAP)
                         break;
 
-                    this->tracked_data->insert({psum_start_addr, 0});
+                    this->tracked_data->insert(psum_start_addr, 0);
                     transaction_request(psum_start_addr, false);
                     still_data = true;
                     psum_reads++;
@@ -332,7 +358,7 @@ namespace core {
                     if (count == OVERLAP)
                         break;
 
-                    this->tracked_data->insert({wgt_start_addr, 0});
+                    this->tracked_data->insert(wgt_start_addr, 0);
                     transaction_request(wgt_start_addr, false);
                     still_data = true;
                     wgt_reads++;
@@ -355,11 +381,7 @@ namespace core {
 
     template <typename T>
     void DRAM<T>::write_transaction_done(unsigned id, uint64_t address, uint64_t _clock_cycle) {
-        if (!request_queue.empty()) {
-            auto tuple = request_queue.front();
-            transaction_request(std::get<0>(tuple), std::get<1>(tuple));
-            request_queue.pop();
-        }
+        issue_queued_request();
     }
 
     template <typename T>
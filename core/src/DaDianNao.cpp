@@ -23,13 +23,13 @@ namespace core {
     }
 
     template <typename T>
-    void DaDianNao<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void DaDianNao<T>::process_tiles(const TilesData<T> &tiles_data) {
 
         this->done_cycle = *this->global_cycle + 1;
         this->ready_cycle = *this->global_cycle + 1;
         this->cycles++;
 
-        for (const auto &tile_data : tiles_data->data) {
+        for (const auto &tile_data : tiles_data.data) {
 
             if (!tile_data.valid)
                 continue;
@@ -70,6 +70,18 @@ namespace core {
         return this->network_width * this->network_width;
     }
 
+    template <typename T>
+    uint64_t DaDianNao<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t pairs = size;
+        if (TCL) {
+            pairs = 0;
+            for (uint64_t i = 0; i < size; ++i)
+                pairs += wgt[i] != 0;
+        }
+
+        return pairs * this->network_width * this->network_width;
+    }
+
     INITIALISE_DATA_TYPES(DaDianNao);
 
 }
\ No newline at end of file
@@ -4,21 +4,33 @@
 namespace core {
 
     void FIFO::flush() {
-        fifo = std::queue<uint64_t>();
+        head = 0;
+        count = 0;
     }
 
     bool FIFO::free_entry() {
-        return fifo.size() < this->MAX_SIZE;
+        return count < this->MAX_SIZE;
     }
 
     void FIFO::insert_addr(uint64_t addr) {
-        fifo.emplace(addr);
+        if (count == fifo.size()) {
+            // Grow the ring geometrically up to the bank size, keeping the addresses in order
+            auto size = std::max<uint64_t>(std::min<uint64_t>(2 * fifo.size() + 16, this->MAX_SIZE), count + 1);
+            std::rotate(fifo.begin(), fifo.begin() + head, fifo.end());
+            fifo.resize(size);
+            head = 0;
+        }
+
+        auto tail = head + count;
+        fifo[tail < fifo.size() ? tail : tail - fifo.size()] = addr;
+        count++;
     }
 
     uint64_t FIFO::evict_addr() {
-        assert(!fifo.empty());
-        auto addr = fifo.front();
-        fifo.pop();
+        assert(count > 0);
+        auto addr = fifo[head];
+        head = head + 1 < fifo.size() ? head + 1 : 0;
+        count--;
         return addr;
     }
 
@@ -154,14 +154,14 @@ namespace core {
     }
 
     template <typename T>
-    void GlobalBuffer<T>::act_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool layer_act_on_chip,
+    void GlobalBuffer<T>::act_read_request(const TilesData<T> &tiles_data, bool layer_act_on_chip,
             bool &read_act) {
 
         try {
 
             auto bank_addr_reads = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(ACT_BANKS, 0));
 
-            for (const auto &tile_data : tiles_data->data) {
+            for (const auto &tile_data : tiles_data.data) {
 
                 if (!tile_data.valid || tile_data.act_addresses.empty())
                     continue;
@@ -178,11 +178,8 @@ namespace core {
                         if (act_addr == NULL_ADDR)
                             continue;
 
-                        if (layer_act_on_chip) {
-                            auto it = (*this->tracked_data).find(act_addr);
-                            if (it == (*this->tracked_data).end())
-                                this->tracked_data->insert({act_addr,  1});
-                        }
+                        if (layer_act_on_chip)
+                            this->tracked_data->insert(act_addr, 1);
 
                         read_act = true;
                         const auto &act_lvl = (*this->tracked_data).at(act_addr);
@@ -237,13 +234,13 @@ namespace core {
     }
 
     template <typename T>
-    void GlobalBuffer<T>::psum_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool &read_psum) {
+    void GlobalBuffer<T>::psum_read_request(const TilesData<T> &tiles_data, bool &read_psum) {
 
         try {
 
             auto bank_addr_reads = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(OUT_BANKS, 0));
 
-            for (const auto &tile_data : tiles_data->data) {
+            for (const auto &tile_data : tiles_data.data) {
 
                 if (!tile_data.valid || tile_data.psum_addresses.empty())
                     continue;
@@ -310,13 +307,13 @@ namespace core {
     }
 
     template <typename T>
-    void GlobalBuffer<T>::wgt_read_request(const std::shared_ptr<TilesData<T>> &tiles_data, bool &read_wgt) {
+    void GlobalBuffer<T>::wgt_read_request(const TilesData<T> &tiles_data, bool &read_wgt) {
 
         try {
 
             auto bank_addr_reads = std::vector<std::vector<int>>(WGT_LEVELS, std::vector<int>(WGT_BANKS, 0));
 
-            for (const auto &tile_data : tiles_data->data) {
+            for (const auto &tile_data : tiles_data.data) {
 
                 if (!tile_data.valid || tile_data.wgt_addresses.empty())
                     continue;
@@ -348,7 +345,7 @@ namespace core {
 
                     for (int lvl = WGT_LEVELS; lvl >= 1; --lvl) {
                         if (lvl >= wgt_lvl) bank_addr_reads[lvl - 1][wgt_bank]++;
-                        else if (lvl != 1) act_eviction_policy[lvl - 1][wgt_bank]->update_status(wgt_addr);
+                        else if (lvl != 1) wgt_eviction_policy[lvl - 1][wgt_bank]->update_status(wgt_addr);
                     }
 
                     (*this->tracked_data).at(wgt_addr) = WGT_LEVELS;
@@ -382,11 +379,11 @@ namespace core {
     }
 
     template <typename T>
-    void GlobalBuffer<T>::write_request(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void GlobalBuffer<T>::write_request(const TilesData<T> &tiles_data) {
 
         auto bank_addr_writes = std::vector<std::vector<int>>(ACT_LEVELS, std::vector<int>(OUT_BANKS, 0));
 
-        for (const auto &tile_data : tiles_data->data) {
+        for (const auto &tile_data : tiles_data.data) {
 
             if (!tile_data.valid || tile_data.out_addresses.empty())
                 continue;
@@ -400,9 +397,8 @@ namespace core {
                 if (out_addr == NULL_ADDR)
                     continue;
 
-                auto it = (*this->tracked_data).find(out_addr);
-                if (it == (*this->tracked_data).end()) {
-                    this->tracked_data->insert({out_addr, 1});
+                if (!this->tracked_data->contains(out_addr)) {
+                    this->tracked_data->insert(out_addr, 1);
 
                     auto &min_addr = std::get<0>(*this->out_addresses);
                     auto &max_addr = std::get<1>(*this->out_addresses);
@@ -464,10 +460,7 @@ namespace core {
             auto max_addr = std::get<1>(*this->act_addresses);
 
             if (min_addr != NULL_ADDR) {
-                auto it = this->tracked_data->find(min_addr);
-                auto it2 = this->tracked_data->find(max_addr);
-                this->tracked_data->erase(it, it2);
-                this->tracked_data->erase(max_addr);
+                this->tracked_data->erase(min_addr, max_addr);
                 *this->act_addresses = {NULL_ADDR, 0};
             }
 
@@ -485,10 +478,7 @@ namespace core {
             auto max_addr = std::get<1>(*this->out_addresses);
 
             if (min_addr != NULL_ADDR) {
-                auto it = this->tracked_data->find(min_addr);
-                auto it2 = this->tracked_data->find(max_addr);
-                this->tracked_data->erase(it, it2);
-                this->tracked_data->erase(max_addr);
+                this->tracked_data->erase(min_addr, max_addr);
                 *this->out_addresses = {NULL_ADDR, 0};
             }
 
@@ -506,10 +496,7 @@ namespace core {
             auto max_addr = std::get<1>(*this->wgt_addresses);
 
             if (min_addr != NULL_ADDR) {
-                auto it = this->tracked_data->find(min_addr);
-                auto it2 = this->tracked_data->find(max_addr);
-                this->tracked_data->erase(it, it2);
-                this->tracked_data->erase(max_addr);
+                this->tracked_data->erase(min_addr, max_addr);
                 *this->wgt_addresses = {NULL_ADDR, 0};
             }
 
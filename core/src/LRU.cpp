@@ -3,32 +3,148 @@
 
 namespace core {
 
+    const uint32_t LRU::NO_SLOT;
+
+    uint64_t LRU::find_position(uint64_t addr) const {
+        if (index.empty())
+            return 0;
+
+        auto mask = index.size() - 1;
+        auto pos = hash(addr);
+        while (index[pos] != NO_SLOT) {
+            if (slot_addr[index[pos]] == addr)
+                return pos;
+            pos = (pos + 1) & mask;
+        }
+        return index.size();
+    }
+
+    void LRU::index_slot(uint32_t slot) {
+        auto mask = index.size() - 1;
+        auto pos = hash(slot_addr[slot]);
+        while (index[pos] != NO_SLOT)
+            pos = (pos + 1) & mask;
+        index[pos] = slot;
+    }
+
+    void LRU::unindex_position(uint64_t pos) {
+        auto mask = index.size() - 1;
+        auto hole = pos;
+        auto next = (pos + 1) & mask;
+        while (index[next] != NO_SLOT) {
+            // A slot can fill the hole if the hole is between its home position and its current one
+            auto home = hash(slot_addr[index[next]]);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                index[hole] = index[next];
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        index[hole] = NO_SLOT;
+    }
+
+    void LRU::grow_index() {
+        index_bits = index.empty() ? 4 : index_bits + 1;
+        index.assign(1ULL << index_bits, NO_SLOT);
+        for (auto slot = head; slot != NO_SLOT; slot = next_slot[slot])
+            index_slot(slot);
+    }
+
+    void LRU::link_front(uint32_t slot) {
+        prev_slot[slot] = NO_SLOT;
+        next_slot[slot] = head;
+        if (head != NO_SLOT) prev_slot[head] = slot;
+        else tail = slot;
+        head = slot;
+    }
+
+    void LRU::unlink(uint32_t slot) {
+        auto prev = prev_slot[slot];
+        auto next = next_slot[slot];
+        if (prev != NO_SLOT) next_slot[prev] = next;
+        else head = next;
+        if (next != NO_SLOT) prev_slot[next] = prev;
+        else tail = prev;
+    }
+
     void LRU::flush() {
-        data.clear();
-        lru.clear();
+        if (count == 0)
+            return;
+
+        slot_addr.clear();
+        prev_slot.clear();
+        next_slot.clear();
+        std::fill(index.begin(), index.end(), NO_SLOT);
+        head = NO_SLOT;
+        tail = NO_SLOT;
+        free_head = NO_SLOT;
+        count = 0;
     }
 
     bool LRU::free_entry() {
-        return data.size() < this->MAX_SIZE;
+        return count < this->MAX_SIZE;
     }
 
     void LRU::insert_addr(uint64_t addr) {
-        data.push_front(addr);
-        lru[addr] = data.begin();
+        auto pos = find_position(addr);
+        if (pos < index.size()) {
+            auto slot = index[pos];
+            unlink(slot);
+            link_front(slot);
+            return;
+        }
+
+        uint32_t slot;
+        if (free_head != NO_SLOT) {
+            slot = free_head;
+            free_head = next_slot[slot];
+            slot_addr[slot] = addr;
+        } else {
+            // Grow the slots geometrically up to the bank size
+            if (slot_addr.size() == slot_addr.capacity()) {
+                auto capacity = std::max<uint64_t>(std::min<uint64_t>(2 * slot_addr.size() + 16, this->MAX_SIZE),
+                        slot_addr.size() + 1);
+                slot_addr.reserve(capacity);
+                prev_slot.reserve(capacity);
+                next_slot.reserve(capacity);
+            }
+            slot = (uint32_t)slot_addr.size();
+            slot_addr.push_back(addr);
+            prev_slot.push_back(NO_SLOT);
+            next_slot.push_back(NO_SLOT);
+        }
+
+        link_front(slot);
+        count++;
+
+        // Keep the index table at most half full
+        if (2 * count > index.size()) grow_index();
+        else index_slot(slot);
     }
 
     uint64_t LRU::evict_addr() {
-        assert(!data.empty());
-        assert(!lru.empty());
-        auto last = data.back();
-        data.pop_back();
-        lru.erase(last);
+        assert(count > 0);
+        auto slot = tail;
+        auto last = slot_addr[slot];
+        unindex_position(find_position(last));
+        unlink(slot);
+        next_slot[slot] = free_head;
+        free_head = slot;
+        count--;
         return last;
     }
 
     void LRU::update_status(uint64_t addr) {
-        data.erase(lru[addr]);
-        insert_addr(addr);
+        auto pos = find_position(addr);
+        if (pos == index.size())
+            return;
+
+        auto slot = index[pos];
+        if (slot == head)
+            return;
+
+        unlink(slot);
+        link_front(slot);
     }
 
 }
@@ -45,11 +45,11 @@ namespace core {
     }
 
     template <typename T>
-    void Laconic<T>::process_linear(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Laconic<T>::process_linear(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -71,10 +71,10 @@ namespace core {
 
                         for (int lane = 0; lane < tile_data.lanes; ++lane) {
 
-                            auto act_bits = std::get<0>(tile_data.act_row.front()[window_idx + lane]);
+                            auto act_bits = tile_data.act_row.value(0, window_idx + lane);
                             act_bits = (act_bits & act_mask) >> act_shift;
 
-                            auto wgt_bits = std::get<0>(tile_data.wgt_row[filter_idx + lane]);
+                            auto wgt_bits = tile_data.wgt_row.values[filter_idx + lane];
                             wgt_bits = (wgt_bits & wgt_mask) >> wgt_shift;
 
                             if (BOOTH_ENCODING) {
@@ -119,10 +119,10 @@ namespace core {
     }
 
     template <typename T>
-    void Laconic<T>::process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Laconic<T>::process_mmul(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (const auto &tile_data : tiles_data->data) {
+        for (const auto &tile_data : tiles_data.data) {
 
             if (!tile_data.valid)
                 continue;
@@ -146,10 +146,10 @@ namespace core {
 
                             for (int lane = 0; lane < tile_data.lanes; ++lane) {
 
-                                auto act_bits = std::get<0>(tile_data.act_row.front()[window_idx + lane]);
+                                auto act_bits = tile_data.act_row.value(0, window_idx + lane);
                                 act_bits = (act_bits & act_mask) >> act_shift;
 
-                                auto wgt_bits = std::get<0>(tile_data.wgt_row[filter_idx + lane]);
+                                auto wgt_bits = tile_data.wgt_row.values[filter_idx + lane];
                                 wgt_bits = (wgt_bits & wgt_mask) >> wgt_shift;
 
                                 if (BOOTH_ENCODING) {
@@ -186,7 +186,7 @@ namespace core {
     }
 
     template <typename T>
-    void Laconic<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Laconic<T>::process_tiles(const TilesData<T> &tiles_data) {
         if (this->linear) process_linear(tiles_data);
         else process_mmul(tiles_data);
     }
@@ -212,6 +212,14 @@ namespace core {
         return effectualBits(act_bits) * effectualBits(wgt_bits);
     }
 
+    template <typename T>
+    uint64_t Laconic<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t bits = 0;
+        for (uint64_t i = 0; i < size; ++i)
+            bits += Laconic<T>::computeBits(act[i], wgt[i]);
+        return bits;
+    }
+
 
     template class Laconic<uint16_t>;
 
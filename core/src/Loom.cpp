@@ -53,41 +53,47 @@ namespace core {
     }
 
     template <typename T>
-    void Loom<T>::process_pe(const BufferRow<T> &row, int idx, int lanes, uint16_t n_mask, bool signed_data,
-            int &min_group_bit, int &max_group_bit, int blk) {
+    void Loom<T>::process_pe(const T *values, int lanes, uint16_t n_mask, bool signed_data, int &min_group_bit,
+            int &max_group_bit, int blk) {
+
+        if (lanes <= 0) return;
 
         auto w_shift = this->PE_WIDTH * blk;
         auto w_mask = ((1u << this->PE_WIDTH) - 1u) << w_shift;
 
+        // The minimum and maximum bits of the lanes are the ones of their bitwise or
+        uint16_t group_bits = 0;
+        #pragma omp simd reduction(|:group_bits)
         for (int lane = 0; lane < lanes; ++lane) {
 
-            auto bits = std::get<0>(row[idx + lane]);
-            bits = (bits & w_mask) >> w_shift;
+            uint16_t bits = (values[lane] & w_mask) >> w_shift;
 
             if(signed_data && (bits & n_mask) != 0) {
                 bits = bits ^ (n_mask - 1u + n_mask);
             }
 
-            const auto &min_max_bits = minMax(bits);
+            group_bits |= bits;
+
+        }
 
-            auto min_bit = std::get<0>(min_max_bits);
-            auto max_bit = std::get<1>(min_max_bits);
+        const auto &min_max_bits = minMax(group_bits);
 
-            if (signed_data) max_bit += 1;
+        auto min_bit = std::get<0>(min_max_bits);
+        auto max_bit = std::get<1>(min_max_bits);
 
-            if(min_bit < min_group_bit) min_group_bit = min_bit;
-            if(max_bit > max_group_bit) max_group_bit = max_bit;
+        if (signed_data) max_bit += 1;
 
-        }
+        if(min_bit < min_group_bit) min_group_bit = min_bit;
+        if(max_bit > max_group_bit) max_group_bit = max_bit;
 
     }
 
     template <typename T>
-    void Loom<T>::process_linear(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Loom<T>::process_linear(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -103,8 +109,8 @@ namespace core {
 
             for (int act_blk = 0; act_blk < this->act_blks; ++act_blk) {
 
-                process_pe(tile_data.act_row.front(), window_idx, tile_data.lanes, act_mask, this->signed_act,
-                           min_act_bit, max_act_bit, act_blk);
+                process_pe(tile_data.act_row.row_values(0) + window_idx, tile_data.lanes, act_mask,
+                           this->signed_act, min_act_bit, max_act_bit, act_blk);
 
                 group_count++;
                 if (group_count >= GROUP_SIZE) {
@@ -137,8 +143,8 @@ namespace core {
 
                     for (int wgt_blk = 0; wgt_blk < this->wgt_blks; ++wgt_blk) {
 
-                        process_pe(tile_data.wgt_row, filter_idx, tile_data.lanes, wgt_mask, this->signed_wgt,
-                                min_wgt_bit, max_wgt_bit, wgt_blk);
+                        process_pe(tile_data.wgt_row.values + filter_idx, tile_data.lanes, wgt_mask,
+                                this->signed_wgt, min_wgt_bit, max_wgt_bit, wgt_blk);
 
                         group_count++;
                         if (group_count >= GROUP_SIZE) {
@@ -153,7 +159,7 @@ namespace core {
                     } // Wgt Spatial Composition
                 } // Filter
 
-                if (group_count < GROUP_SIZE)
+                if (group_count < GROUP_SIZE && group < filter_cycles.size())
                     filter_cycles[group] = MINOR_BIT ? min_wgt_bit > max_wgt_bit ? 1 + this->signed_wgt :
                             max_wgt_bit - min_wgt_bit + 1 : max_wgt_bit + 1;
 
@@ -201,10 +207,10 @@ namespace core {
 
 
     template <typename T>
-    void Loom<T>::process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Loom<T>::process_mmul(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (const auto &tile_data : tiles_data->data) {
+        for (const auto &tile_data : tiles_data.data) {
 
             if (!tile_data.valid)
                 continue;
@@ -221,8 +227,8 @@ namespace core {
 
                 for (int act_blk = 0; act_blk < this->act_blks; ++act_blk) {
 
-                    process_pe(tile_data.act_row.front(), window_idx, tile_data.lanes, act_mask, this->signed_act,
-                            min_act_bit, max_act_bit, act_blk);
+                    process_pe(tile_data.act_row.row_values(0) + window_idx, tile_data.lanes, act_mask,
+                            this->signed_act, min_act_bit, max_act_bit, act_blk);
 
                     group_count++;
                     if (group_count >= GROUP_SIZE) {
@@ -237,7 +243,7 @@ namespace core {
                 } // Act Spatial Composition
             } // Window
 
-            if (group_count < GROUP_SIZE)
+            if (group_count < GROUP_SIZE && group < window_cycles.size())
                 window_cycles[group] = MINOR_BIT ? min_act_bit > max_act_bit ? 1 + this->signed_act :
                         max_act_bit - min_act_bit + 1 : max_act_bit + 1;
 
@@ -255,8 +261,8 @@ namespace core {
 
                     for (int wgt_blk = 0; wgt_blk < this->wgt_blks; ++wgt_blk) {
 
-                        process_pe(tile_data.wgt_row, filter_idx, tile_data.lanes, wgt_mask, this->signed_wgt,
-                                min_wgt_bit, max_wgt_bit, wgt_blk);
+                        process_pe(tile_data.wgt_row.values + filter_idx, tile_data.lanes, wgt_mask,
+                                this->signed_wgt, min_wgt_bit, max_wgt_bit, wgt_blk);
 
                         group_count++;
                         if (group_count >= GROUP_SIZE) {
@@ -271,7 +277,7 @@ namespace core {
                     } // Wgt Spatial Composition
                 } // Filter
 
-                if (group_count < GROUP_SIZE)
+                if (group_count < GROUP_SIZE && group < filter_cycles.size())
                     filter_cycles[group] = MINOR_BIT ? min_wgt_bit > max_wgt_bit ? 1 + this->signed_wgt :
                             max_wgt_bit - min_wgt_bit + 1 : max_wgt_bit + 1;
 
@@ -309,7 +315,7 @@ namespace core {
     }
 
     template <typename T>
-    void Loom<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Loom<T>::process_tiles(const TilesData<T> &tiles_data) {
         if (this->linear) process_linear(tiles_data);
         else process_mmul(tiles_data);
     }
@@ -362,6 +368,14 @@ namespace core {
 
     }
 
+    template <typename T>
+    uint64_t Loom<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t bits = 0;
+        for (uint64_t i = 0; i < size; ++i)
+            bits += Loom<T>::computeBits(act[i], wgt[i]);
+        return bits;
+    }
+
 
     template class Loom<uint16_t>;
 
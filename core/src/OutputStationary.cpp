@@ -87,35 +87,54 @@ namespace core {
         auto start_x = start_rem / last_act_blk;
         auto start_ch = start_rem % last_act_blk;
 
+        // Blocks of a window from its first position, the same for all the windows
         auto window_blks = end_act_blk - start_act_blk;
+        auto window_offsets = std::vector<uint64_t>();
+        window_offsets.reserve(window_blks);
+
+        auto y = start_y;
+        auto x = start_x;
+        auto ch = start_ch;
+        while (y < Ky && window_offsets.size() != window_blks) {
+            while (x < Kx && window_offsets.size() != window_blks) {
+                while (ch < last_act_blk && window_offsets.size() != window_blks) {
+                    window_offsets.push_back(act_address_map.block(y, x, start_group + ch));
+                    ch++;
+                }
+                ch = 0;
+                x++;
+            }
+            x = 0;
+            y++;
+        }
+
         auto total_windows = end_window - start_window;
-        auto read_addresses = std::vector<uint64_t>(total_windows * window_blks, NULL_ADDR);
-        for (int w = 0; w < total_windows; ++w) {
-            auto window = start_window + w;
+        if (window_offsets.empty() || total_windows == 0)
+            return std::vector<AddressRange>();
+
+        // Mark the blocks of all the windows in a bitmap, the windows overlap
+        auto window_block = [&](uint32_t window) {
             auto x_window = (window % out_x) * this->stride;
             auto y_window = (window / out_x) * this->stride;
-
-            auto y = start_y;
-            auto x = start_x;
-            auto ch = start_ch;
-
-            int idx = 0;
-            while (y < Ky && idx != window_blks) {
-                while (x < Kx && idx != window_blks) {
-                    while (ch < last_act_blk && idx != window_blks) {
-                        read_addresses[w * window_blks + idx] =
-                                act_address_map[y_window + y][x_window + x][start_group + ch];
-                        idx++;
-                        ch++;
-                    }
-                    ch = 0;
-                    x++;
-                }
-                x = 0;
-                y++;
-            }
+            return act_address_map.block(y_window, x_window, 0);
+        };
+
+        auto first_block = window_block(start_window) + *std::min_element(window_offsets.begin(),
+                window_offsets.end());
+        auto last_block = window_block(end_window - 1) + *std::max_element(window_offsets.begin(),
+                window_offsets.end());
+        auto read_blocks = std::vector<bool>(last_block - first_block + 1, false);
+        for (auto window = start_window; window < end_window; ++window) {
+            auto origin = window_block(window) - first_block;
+            for (const auto &offset : window_offsets)
+                read_blocks[origin + offset] = true;
         }
 
+        auto read_addresses = std::vector<uint64_t>();
+        for (uint64_t blk = 0; blk < read_blocks.size(); ++blk)
+            if (read_blocks[blk])
+                read_addresses.push_back(act_address_map.address(first_block + blk));
+
         return this->dram->compress_addresses(read_addresses);
     }
 
@@ -135,50 +154,26 @@ namespace core {
             Ny = act_shape[3];
         }
 
-        // Generate address map
-        auto channel_blks = ceil(act_channels / (double)this->dram->getActValuesPerBlock());
-        act_address_map = std::vector<std::vector<std::vector<uint64_t>>>(Ny, std::vector<std::vector<uint64_t>>(Nx,
-                std::vector<uint64_t>(channel_blks)));
-
-        // Column third
-        for (int y = 0; y < Ny; ++y) {
-
-            // Row second
-            for (int x = 0; x < Nx; ++x) {
-
-                // Store channel-first
-                for (int k = 0; k < channel_blks; ++k) {
-                    act_address_map[y][x][k] = this->dram->getStartActAddress() + next_act_address;
-                    next_act_address += this->dram->getWidth();
-                }
-            }
-        }
-
-        act_bank_map = ActBankMap(Ny, std::vector<int>(Nx));
-
-        int bank = 0;
-        int bkp_bank = 0;
-        for (int y = 0; y < Ny; ++y) {
-            for (int x = 0; x < Nx; ++x) {
-                if (y % this->stride == 0 && x == 0)
-                    bank = bkp_bank;
+        // Generate address map: column third, row second, and channel-first
+        auto channel_blks = (uint64_t)ceil(act_channels / (double)this->dram->getActValuesPerBlock());
+        act_address_map = AddressMap(this->dram->getStartActAddress() + next_act_address, Nx, channel_blks,
+                this->dram->getWidth());
+        next_act_address += Ny * Nx * channel_blks * this->dram->getWidth();
 
-                act_bank_map[y][x] = bank;
-                bank = (bank + 1) % this->gbuffer->getActBanks();
-
-                if (y % this->stride == 0 && x == out_x * this->stride - 1)
-                    bkp_bank = bank;
-            }
-        }
+        // The rows that start a window continue the banks after the last column of the windows of the previous one
+        uint64_t window_columns = out_x * this->stride;
+        auto window_banks = window_columns <= Nx ? window_columns : 0;
+        act_bank_map = ActBankMap(Nx, window_banks, this->stride, this->gbuffer->getActBanks());
 
     }
 
     template <typename T>
     void OutputStationary<T>::fill_weight_buffer() {
 
-        // Data buffer
-        weight_buffer = Buffer<T>(filter_sets * groups, BufferSet<T>(max_buffer_time,
-                BufferRow<T>(this->EF_ROWS * this->EF_LANES, {0, 0, 0})));
+        // Data buffer, reusing the memory of the previous layers
+        weight_buffer.resize(filter_sets * groups);
+        for (auto &weight_set : weight_buffer)
+            weight_set.assign(max_buffer_time, this->EF_ROWS * this->EF_LANES);
 
         const std::vector<size_t> &wgt_shape = this->wgt->getShape();
 
@@ -211,7 +206,7 @@ namespace core {
                                 index = depthwise ? filter_pos : index;
                                 auto wgt_bits = this->wgt->get(start_group + m, ch, x, y);
                                 int pos = filter_pos * this->EF_LANES + index;
-                                weight_buffer[set_wgt][buffer_time][pos] = {wgt_bits, buffer_time, index};
+                                weight_buffer[set_wgt].set(buffer_time, pos, wgt_bits, buffer_time, index);
 
                                 index++;
                                 if (index == this->EF_LANES) {
@@ -236,12 +231,13 @@ namespace core {
         }
 
         // Addresses buffer
-        auto accesses_per_filter = (uint64_t)ceil(this->EF_LANES / (double)this->dram->getWgtValuesPerBlock())
-                * this->EF_ROWS;
-        if (this->arch->schedule()) accesses_per_filter += (uint64_t)ceil(this->EF_LANES *
-                this->scheduler->getMetadataBits() / (double)this->dram->getWidth()) * this->EF_ROWS;
-        wgt_address_buffer = AddressBuffer(filter_sets * groups, AddressBufferSet(max_buffer_time,
-                AddressBufferRow(accesses_per_filter, NULL_ADDR)));
+        wgt_row_accesses = weight_row_accesses(this->EF_LANES, this->EF_ROWS, this->dram->getWgtValuesPerBlock());
+        wgt_row_addresses = std::vector<uint64_t>((uint64_t)filter_sets * groups * max_buffer_time, NULL_ADDR);
+        wgt_end_time = std::vector<uint64_t>(filter_sets * groups, 0);
+
+        // The rows skipped by the schedule keep their space, the next layer starts at the same address whatever the
+        // weight values are
+        auto first_wgt_address = next_wgt_address;
 
         auto tiles = this->arch->getTiles();
         auto filter_sets_per_set = ceil(filter_sets / (double)tiles);
@@ -267,7 +263,7 @@ namespace core {
                             continue;
 
                         if (this->arch->schedule()) {
-                            bool zero_line = this->scheduler->check_zero_line(this->weight_buffer[mm][y]);
+                            bool zero_line = this->scheduler->check_zero_line(this->weight_buffer[mm], y);
                             if (skip_buf[t] < this->scheduler->getLookaheadH() && zero_line) {
                                 skip_buf[t]++;
                                 continue;
@@ -275,11 +271,13 @@ namespace core {
                             skip_buf[t] = 0;
                         }
 
-                        // Buffer width first
-                        for (int x = 0; x < accesses_per_filter; ++x) {
-                            this->wgt_address_buffer[mm][y][x] = this->dram->getStartWgtAddress() + next_wgt_address;
-                            next_wgt_address += this->dram->getWidth();
-                        }
+                        // Buffer width first, the addresses of the row are consecutive
+                        wgt_row_addresses[(uint64_t)mm * max_buffer_time + y] =
+                                this->dram->getStartWgtAddress() + next_wgt_address;
+                        next_wgt_address += wgt_row_accesses * this->dram->getWidth();
+
+                        if (y > wgt_end_time[mm])
+                            wgt_end_time[mm] = y;
 
                     }
                 }
@@ -290,58 +288,69 @@ namespace core {
             }
         }
 
+        next_wgt_address = first_wgt_address + (uint64_t)groups * filter_sets * max_buffer_time * wgt_row_accesses *
+                this->dram->getWidth();
 
-        // Banks buffer
-        wgt_bank_buffer = BankBuffer(filter_sets * groups, BankBufferSet(max_buffer_time,
-                BankBufferRow(accesses_per_filter)));
-        wgt_end_time = std::vector<uint64_t>(filter_sets * groups, 0);
-
-        int bank = 0;
-        for (int m = 0; m < filter_sets * groups; ++m) {
-            for (int f = 0; f < accesses_per_filter; ++f) {
-
-                int skip_buf = 0;
-                for (int y = 0; y < max_buffer_time; ++y) {
+    }
 
-                    if (this->arch->schedule()) {
-                        bool zero_line = this->scheduler->check_zero_line(this->weight_buffer[m][y]);
-                        if (skip_buf < this->scheduler->getLookaheadH() && zero_line) {
-                            skip_buf++;
-                            continue;
-                        }
-                        skip_buf = 0;
-                    }
+    template <typename T>
+    uint64_t OutputStationary<T>::weight_row_accesses(uint32_t lanes, uint32_t rows,
+            uint32_t wgt_values_per_block) const {
+        auto row_accesses = (uint64_t)ceil(lanes / (double)wgt_values_per_block) * rows;
+        if (this->arch->schedule()) row_accesses += (uint64_t)ceil(lanes * this->scheduler->getMetadataBits() /
+                (double)this->dram->getWidth()) * rows;
+        return row_accesses;
+    }
 
-                    if (y > wgt_end_time[m])
-                        wgt_end_time[m] = y;
-                    this->wgt_bank_buffer[m][y][f] = bank;
-                }
+    template <typename T>
+    StridedAddressRow OutputStationary<T>::wgt_address_row(uint64_t set, uint64_t time) const {
+        auto first = wgt_row_addresses[set * max_buffer_time + time];
+        return StridedAddressRow(first, wgt_row_accesses, first == NULL_ADDR ? 0 : this->dram->getWidth());
+    }
 
-                bank = (bank + 1) % this->gbuffer->getWgtBanks();
+    template <typename T>
+    RoundRobinBankRow OutputStationary<T>::wgt_bank_row(uint64_t set) const {
+        // The banks are assigned round-robin to the accesses of the filter sets
+        auto banks = this->gbuffer->getWgtBanks();
+        return RoundRobinBankRow((set * wgt_row_accesses) % banks, wgt_row_accesses, banks);
+    }
 
-            }
+    /** Set the rows of a buffer shared with the tiles to a value, reusing it once the tiles do not read it anymore
+     * @param buffer    Buffer (Overwritten)
+     * @param rows      Number of rows
+     * @param width     Number of values per row
+     * @param value     Value of all the positions
+     */
+    template <typename V>
+    void assign_rows(std::shared_ptr<std::vector<std::vector<V>>> &buffer, uint64_t rows, uint64_t width, V value) {
+        if (!buffer || buffer.use_count() != 1) {
+            buffer = std::make_shared<std::vector<std::vector<V>>>(rows, std::vector<V>(width, value));
+            return;
         }
-
+        buffer->resize(rows);
+        for (auto &row : *buffer)
+            row.assign(width, value);
     }
 
     template <typename T>
     void OutputStationary<T>::fill_window_buffer(uint32_t group_idx) {
 
         auto recurrence = std::static_pointer_cast<OutputStationary<T>::NodeOutS>
-                (this->on_chip_graph.front())->recurrence;
+                (this->current_node())->recurrence;
 
-        if (windows.empty()) {
+        if (windows->empty()) {
             throw std::runtime_error("Window indices may not be empty");
         }
 
-        auto num_windows = this->linear ? this->EF_COLUMNS : windows.size();
-        window_buffer = BufferSet<T>(max_buffer_time, BufferRow<T>(num_windows * this->EF_LANES, {0.0f, 0, 0}));
+        // Reuse the buffers once the tiles do not read them anymore
+        auto num_windows = this->linear ? this->EF_COLUMNS : windows->size();
+        if (window_buffer && window_buffer.use_count() == 1)
+            window_buffer->assign(max_buffer_time, num_windows * this->EF_LANES);
+        else window_buffer = std::make_shared<BufferSet<T>>(max_buffer_time, num_windows * this->EF_LANES);
 
         auto accesses_per_window = (uint64_t)ceil(this->EF_LANES / (double)this->dram->getActValuesPerBlock());
-        window_address_buffer = AddressBufferSet(max_buffer_time, AddressBufferRow(accesses_per_window *
-                windows.size(), NULL_ADDR));
-
-        window_bank_buffer = BankBufferSet(max_buffer_time, BankBufferRow(accesses_per_window * windows.size(), -1));
+        assign_rows(window_address_buffer, max_buffer_time, accesses_per_window * windows->size(), NULL_ADDR);
+        assign_rows(window_bank_buffer, max_buffer_time, accesses_per_window * windows->size(), -1);
 
         const std::vector<size_t> &act_shape = this->act->getShape();
         const std::vector<size_t> &wgt_shape = this->wgt->getShape();
@@ -355,9 +364,9 @@ namespace core {
         auto channels = depthwise ? filters_per_group : wgt_channels;
 
         int next_column = 0;
-        for (int w = 0; w < windows.size(); ++w) {
-            auto x_window = std::get<0>(windows[w]) * this->stride;
-            auto y_window = std::get<1>(windows[w]) * this->stride;
+        for (int w = 0; w < windows->size(); ++w) {
+            auto x_window = std::get<0>((*windows)[w]) * this->stride;
+            auto y_window = std::get<1>((*windows)[w]) * this->stride;
 
             auto start_group = group_idx * channels;
 
@@ -383,13 +392,13 @@ namespace core {
 
                             auto column = this->linear ? next_column : w;
                             int pos = column * this->EF_LANES + index;
-                            window_buffer[buffer_time][pos] = {act_bits, buffer_time, index};
+                            window_buffer->set(buffer_time, pos, act_bits, buffer_time, index);
 
                             int addr_pos = w * accesses_per_window + index / this->dram->getActValuesPerBlock();
-                            window_address_buffer[buffer_time][addr_pos] = act_address_map[y_window + y]
-                                    [x_window + x][(start_group + ch) / this->dram->getActValuesPerBlock()];
+                            (*window_address_buffer)[buffer_time][addr_pos] = act_address_map(y_window + y,
+                                    x_window + x, (start_group + ch) / this->dram->getActValuesPerBlock());
 
-                            window_bank_buffer[buffer_time][addr_pos] = act_bank_map[y_window + y][x_window + x];
+                            (*window_bank_buffer)[buffer_time][addr_pos] = act_bank_map(y_window + y, x_window + x);
 
                             index++;
                             if (index == this->EF_LANES) {
@@ -416,7 +425,7 @@ namespace core {
 
     template<typename T>
     uint64_t OutputStationary<T>::calculate_outputs() {
-        const auto &current_node = std::static_pointer_cast<NodeOutS>(this->on_chip_graph.front());
+        const auto &current_node = std::static_pointer_cast<NodeOutS>(this->current_node());
 
         const auto &time_step = current_node->time_step;
         const auto &max_time = current_node->max_time;
@@ -438,6 +447,78 @@ namespace core {
         return total_outputs;
     }
 
+    template <typename T>
+    typename Control<T>::LayerState OutputStationary<T>::getLayerState() const {
+        auto state = Control<T>::getLayerState();
+        state.next_act_address = next_act_address;
+        state.next_wgt_address = next_wgt_address;
+        state.next_out_address = next_out_address;
+        return state;
+    }
+
+    template <typename T>
+    void OutputStationary<T>::setLayerState(const typename Control<T>::LayerState &state) {
+        Control<T>::setLayerState(state);
+        next_act_address = state.next_act_address;
+        next_wgt_address = state.next_wgt_address;
+        next_out_address = state.next_out_address;
+    }
+
+    template <typename T>
+    typename Control<T>::LayerState OutputStationary<T>::next_layer_state(
+            const typename Control<T>::LayerState &state, const std::vector<size_t> &act_shape,
+            const std::vector<size_t> &wgt_shape, uint32_t act_prec, uint32_t wgt_prec, bool _linear, bool __3dim,
+            int _stride) const {
+
+        auto next_state = Control<T>::next_layer_state(state, act_shape, wgt_shape, act_prec, wgt_prec, _linear,
+                __3dim, _stride);
+
+        auto width = this->dram->getWidth();
+        auto act_values_per_block = (uint32_t)(width / this->dram_data_size(act_prec));
+        auto wgt_values_per_block = (uint32_t)(width / this->dram_data_size(wgt_prec));
+
+        uint32_t EF_LANES = this->arch->getLanes();
+        uint32_t EF_ROWS = this->arch->getRows() / (uint32_t)ceil(wgt_prec / (double)this->arch->getPeWidth());
+        if (EF_ROWS == 0)
+            return next_state;
+
+        // Activations as mapped by generate_memory_maps
+        auto act_channels = __3dim ? act_shape[2] : act_shape[1];
+        uint64_t Nx = __3dim ? 1 : act_shape[2];
+        uint64_t Ny = __3dim ? 1 : act_shape[3];
+
+        auto channel_blks = (uint64_t)ceil(act_channels / (double)act_values_per_block);
+        next_state.next_act_address += Ny * Nx * channel_blks * width;
+
+        // Weights as mapped by fill_weight_buffer, every row of the buffer takes its space
+        auto num_filters = wgt_shape[0];
+        auto wgt_channels = wgt_shape[1];
+        auto Kx = wgt_shape[2];
+        auto Ky = wgt_shape[3];
+
+        uint64_t layer_groups, layer_filters_per_group;
+        if (wgt_channels == 1 && act_channels != 1) {
+            auto MIN_DIM = std::min(EF_LANES, EF_ROWS);
+            EF_LANES = MIN_DIM;
+            EF_ROWS = MIN_DIM;
+
+            layer_groups = (uint64_t)ceil(num_filters / (double)MIN_DIM);
+            layer_filters_per_group = MIN_DIM;
+        } else {
+            layer_groups = act_channels / wgt_channels == 2 ? 2 : 1;
+            layer_filters_per_group = (uint64_t)ceil(num_filters / (double)layer_groups);
+        }
+
+        auto layer_filter_sets = (uint64_t)ceil(layer_filters_per_group / (double)EF_ROWS);
+        auto round_wgt_channels = (int)ceil(wgt_channels / (double)EF_LANES) * EF_LANES;
+        auto layer_max_buffer_time = (uint64_t)ceil(round_wgt_channels * Kx * Ky / (double)EF_LANES);
+
+        next_state.next_wgt_address += layer_groups * layer_filter_sets * layer_max_buffer_time *
+                weight_row_accesses(EF_LANES, EF_ROWS, wgt_values_per_block) * width;
+
+        return next_state;
+    }
+
     template <typename T>
     void OutputStationary<T>::configure_layer(const std::shared_ptr<base::Array<T>> &_act,
             const std::shared_ptr<base::Array<T>> &_wgt, uint32_t act_prec, uint32_t wgt_prec, bool _linear,
@@ -455,6 +536,9 @@ namespace core {
         window_buffer_filled = false;
         filter_buffer_filled = false;
         tiles_done = false;
+        windows = std::make_shared<std::vector<WindowCoord>>();
+        filters.reset();
+        linear_windows = std::make_shared<std::vector<WindowCoord>>(this->EF_COLUMNS, WindowCoord(0, 0));
 
         const std::vector<size_t> &act_shape = this->act->getShape();
         const std::vector<size_t> &wgt_shape = this->wgt->getShape();
@@ -65,7 +65,7 @@ namespace core {
     template <typename T>
     typename SCNN<T>::Tile_stats SCNN<T>::computeSCNNTile(int n, int ct, int ck, int kc, int tw, int th, uint64_t X,
             uint64_t Y, int Kc, uint64_t K, uint64_t W, uint64_t H, uint64_t R, uint64_t S, int stride, int padding,
-            const base::Array<T> &act, const base::Array<T> &wgt) {
+            const base::Array<T> &act, const base::Array<T> &wgt, int threads) {
 
         Tile_stats tile_stats;
         tile_stats.cycles = 0;
@@ -81,11 +81,10 @@ namespace core {
         tile_stats.f_loop = 0;
         tile_stats.offchip_weight_reads = 0;
 
-        std::vector<uint32_t> tile_cycles;
-        std::vector<uint32_t> tile_dense_cycles;
-        std::vector<uint32_t> tile_i_loop;
-        uint32_t wgt_size = 0;
+        // Every PE writes its own slot, reduced in order after the grid
+        std::vector<Tile_stats> grid_stats = std::vector<Tile_stats>(Wt * Ht, Tile_stats());
 
+        #pragma omp parallel for collapse(2) num_threads(threads) if(threads > 1) schedule(dynamic)
         for(int pex = 0; pex < Wt; pex++) {
             for(int pey = 0; pey < Ht; pey++) {
                 int x_begin = pex * tw, y_begin = pey * th, k_begin = kc;
@@ -131,7 +130,6 @@ namespace core {
                 uint32_t PE_accumulator_updates = 0;
                 uint32_t PE_i_loop = 0;
                 uint32_t PE_f_loop = 0;
-                uint32_t PE_wgt_size = 0;
 
                 for(int sx = 0; sx < stride; sx++) {
                     for(int sy = 0; sy < stride; sy++) {
@@ -139,7 +137,6 @@ namespace core {
                         const PE_stats &pe_stats = computeSCNNPE(W, H, stride, act_queue[sx][sy], wgt_queue[sx][sy]);
 
                         auto stride_wgt_size = (uint32_t)(ceil(wgt_queue[sx][sy].size()/(double)F))*F;
-                        PE_wgt_size += stride_wgt_size;
 
                         PE_cycles += pe_stats.cycles;
                         PE_dense_cycles += (uint32_t)(ceil(dense_act_counter[sx][sy]/(double)I) *
@@ -150,26 +147,46 @@ namespace core {
                         PE_i_loop += pe_stats.i_loop;
                         PE_f_loop += pe_stats.f_loop;
 
-                        tile_stats.weight_buff_reads += stride_wgt_size;
-                        tile_stats.act_buff_reads += (uint64_t)(ceil(act_queue[sx][sy].size()/(double)I))*I;
+                        grid_stats[pex * Ht + pey].weight_buff_reads += stride_wgt_size;
+                        grid_stats[pex * Ht + pey].act_buff_reads +=
+                                (uint64_t)(ceil(act_queue[sx][sy].size()/(double)I))*I;
                     }
                 }
-                wgt_size = PE_wgt_size;
-                tile_cycles.push_back(PE_cycles);
-                tile_dense_cycles.push_back(PE_dense_cycles);
-                tile_i_loop.push_back(PE_i_loop);
-
-                tile_stats.idle_bricks += PE_f_loop * I * F - PE_mults;
-                tile_stats.mults += PE_mults;
-                tile_stats.idle_conflicts += PE_idle_conflicts;
-                tile_stats.accumulator_updates += PE_accumulator_updates;
-                tile_stats.i_loop += PE_i_loop;
-                tile_stats.f_loop += PE_f_loop;
+                auto &pe_tile_stats = grid_stats[pex * Ht + pey];
+                pe_tile_stats.cycles = PE_cycles;
+                pe_tile_stats.dense_cycles = PE_dense_cycles;
+                pe_tile_stats.idle_bricks = PE_f_loop * I * F - PE_mults;
+                pe_tile_stats.mults = PE_mults;
+                pe_tile_stats.idle_conflicts = PE_idle_conflicts;
+                pe_tile_stats.accumulator_updates = PE_accumulator_updates;
+                pe_tile_stats.i_loop = PE_i_loop;
+                pe_tile_stats.f_loop = PE_f_loop;
             }
         }
 
+        std::vector<uint64_t> tile_cycles;
+        std::vector<uint64_t> tile_dense_cycles;
+        std::vector<uint64_t> tile_i_loop;
+        uint64_t wgt_size = 0;
+
+        for (const auto &pe_tile_stats : grid_stats) {
+            wgt_size = pe_tile_stats.weight_buff_reads;
+            tile_cycles.push_back(pe_tile_stats.cycles);
+            tile_dense_cycles.push_back(pe_tile_stats.dense_cycles);
+            tile_i_loop.push_back(pe_tile_stats.i_loop);
+
+            tile_stats.idle_bricks += pe_tile_stats.idle_bricks;
+            tile_stats.mults += pe_tile_stats.mults;
+            tile_stats.idle_conflicts += pe_tile_stats.idle_conflicts;
+            tile_stats.accumulator_updates += pe_tile_stats.accumulator_updates;
+            tile_stats.i_loop += pe_tile_stats.i_loop;
+            tile_stats.f_loop += pe_tile_stats.f_loop;
+            tile_stats.weight_buff_reads += pe_tile_stats.weight_buff_reads;
+            tile_stats.act_buff_reads += pe_tile_stats.act_buff_reads;
+        }
+
         auto tile_max_cycles = *std::max_element(tile_cycles.begin(), tile_cycles.end());
-        uint32_t tile_idle_pe = 0;
+        uint64_t tile_idle_pe = 0;
         for(const auto &PE_cycles : tile_cycles)
             tile_idle_pe += tile_max_cycles - PE_cycles;
         auto tile_max_i_loop =  *std::max_element(tile_i_loop.begin(), tile_i_loop.end());
@@ -218,6 +235,14 @@ namespace core {
 
             if (rnn) continue;
 
+            // Samples of the layer simulated by this shard
+            std::vector<int> samples;
+            uint64_t layer_batch = this->FAST_MODE ? 1 : layer.getActivations().getShape()[0];
+            for (int n = 0; n < layer_batch; ++n) {
+                if (SHARD.owns(n * network.getNumLayers() + layer_it)) samples.push_back(n);
+            }
+            if (samples.empty()) continue;
+
             if (!QUIET) std::cout << "Simulating layer: " << layer.getName() << std::endl;
 
             base::Array<T> act = layer.getActivations();
@@ -246,11 +271,9 @@ namespace core {
             const std::vector<size_t> &act_shape = act.getShape();
             const std::vector<size_t> &wgt_shape = wgt.getShape();
 
-            auto N = act_shape[0];
             auto C = act_shape[1];
             auto X = act_shape[2];
             auto Y = act_shape[3];
-            if(this->FAST_MODE) N = 1;
 
             auto K = wgt_shape[0];
             auto Ck = wgt_shape[1];
@@ -272,6 +295,10 @@ namespace core {
             // Fix for MobileNet
             if(Ck == 1 && C != 1) Kc = 1;
 
+            if(Kc == 0)
+                throw std::runtime_error("SCNN output accumulator is too small for the tiles of layer " +
+                        layer.getName());
+
             X = (int)(ceil(X/(double)Wt))*Wt;
             Y = (int)(ceil(Y/(double)Ht))*Ht;
             tw = (uint32_t)X/Wt;
@@ -279,66 +306,103 @@ namespace core {
 
             act.grid_zero_pad(X ,Y);
 
-            for(int n = 0; n < N; n++) {
-                for(int kc = 0; kc < K; kc += Kc) {
-
-                    // Two towers alexnet
-                    int ct = 0;
-                    if(kc >= Kg) ct = (int)Ck;
-
-                    // Fix for MobileNet
-                    if(Ck == 1 && C != 1) ct = kc;
-
-                    for(int ck = 0; ck < Ck; ck++) {
-                        auto tile_stats = computeSCNNTile(n, ct, ck, kc, tw, th, X, Y, Kc, K, W, H, R, S, stride,
-                                padding, act, wgt);
-
-                        cycles->value[layer_it][n] += tile_stats.cycles;
-                        dense_cycles->value[layer_it][n] += tile_stats.dense_cycles;
-                        mults->value[layer_it][n] += tile_stats.mults;
-                        idle_bricks->value[layer_it][n] += tile_stats.idle_bricks;
-                        idle_conflicts->value[layer_it][n] += tile_stats.idle_conflicts;
-                        idle_pe->value[layer_it][n] += tile_stats.idle_pe;
-                        weight_buff_reads->value[layer_it][n] += tile_stats.weight_buff_reads;
-                        act_buff_reads->value[layer_it][n] += tile_stats.act_buff_reads;
-                        accumulator_updates->value[layer_it][n] += tile_stats.accumulator_updates;
-                        i_loop->value[layer_it][n] += tile_stats.i_loop;
-                        f_loop->value[layer_it][n] += tile_stats.f_loop;
-                        offchip_weight_reads->value[layer_it][n] += tile_stats.offchip_weight_reads;
-                    }
+            // Flatten the tiles of every sample and group of output channels, each one with its own partial stats
+            auto groups_per_sample = (uint64_t)ceil(K / (double)Kc);
+            auto num_tiles = samples.size() * groups_per_sample;
+            std::vector<Tile_stats> partial_stats = std::vector<Tile_stats>(num_tiles, Tile_stats());
+            std::vector<uint64_t> partial_halo_transfers = std::vector<uint64_t>(num_tiles, 0);
+            std::vector<uint64_t> partial_idle_halo = std::vector<uint64_t>(num_tiles, 0);
+
+            // Not enough tiles for all the threads: evaluate the PEs of the grid in parallel instead
+            bool grid_parallel = num_tiles < N_THREADS;
+            int tile_threads = grid_parallel ? 1 : N_THREADS;
+            int grid_threads = grid_parallel ? N_THREADS : 1;
+
+            #pragma omp parallel for num_threads(tile_threads) if(tile_threads > 1) schedule(dynamic)
+            for(int tile = 0; tile < num_tiles; tile++) {
+                int n = samples[tile / groups_per_sample];
+                int kc = (tile % groups_per_sample) * Kc;
+                auto &tile_partial = partial_stats[tile];
+
+                // Two towers alexnet
+                int ct = 0;
+                if(kc >= Kg) ct = (int)Ck;
+
+                // Fix for MobileNet
+                if(Ck == 1 && C != 1) ct = kc;
+
+                for(int ck = 0; ck < Ck; ck++) {
+                    auto tile_stats = computeSCNNTile(n, ct, ck, kc, tw, th, X, Y, Kc, K, W, H, R, S, stride,
+                            padding, act, wgt, grid_threads);
+
+                    tile_partial.cycles += tile_stats.cycles;
+                    tile_partial.dense_cycles += tile_stats.dense_cycles;
+                    tile_partial.mults += tile_stats.mults;
+                    tile_partial.idle_bricks += tile_stats.idle_bricks;
+                    tile_partial.idle_conflicts += tile_stats.idle_conflicts;
+                    tile_partial.idle_pe += tile_stats.idle_pe;
+                    tile_partial.weight_buff_reads += tile_stats.weight_buff_reads;
+                    tile_partial.act_buff_reads += tile_stats.act_buff_reads;
+                    tile_partial.accumulator_updates += tile_stats.accumulator_updates;
+                    tile_partial.i_loop += tile_stats.i_loop;
+                    tile_partial.f_loop += tile_stats.f_loop;
+                    tile_partial.offchip_weight_reads += tile_stats.offchip_weight_reads;
+                }
 
-                    // resolve halos
-                    // compute the areas of the halo regions around a non edge PE
-                    // that is, how many psums need to get transferred
-
-                    const int DIM = 3;
-                    int x_vec[] = {(int)R - 1 - padding, (int)tw, padding};
-                    int y_vec[] = {(int)S - 1 - padding, (int)th, padding};
-                    int max_psum = 0;
-                    uint32_t tmp_halo_transfers = 0;
-
-                    for(int x = 0; x < DIM; x++) {
-                        for (int y = 0; y < DIM; y++) {
-                            int psum = x_vec[x] * y_vec[y];
-                            if(x != 1 || y != 1)  {
-                                tmp_halo_transfers += psum;
-                                if(psum > max_psum)
-                                    max_psum = psum;
-                            }
+                // resolve halos
+                // compute the areas of the halo regions around a non edge PE
+                // that is, how many psums need to get transferred
+
+                const int DIM = 3;
+                int x_vec[] = {(int)R - 1 - padding, (int)tw, padding};
+                int y_vec[] = {(int)S - 1 - padding, (int)th, padding};
+                int max_psum = 0;
+                uint32_t tmp_halo_transfers = 0;
+
+                for(int x = 0; x < DIM; x++) {
+                    for (int y = 0; y < DIM; y++) {
+                        int psum = x_vec[x] * y_vec[y];
+                        if(x != 1 || y != 1)  {
+                            tmp_halo_transfers += psum;
+                            if(psum > max_psum)
+                                max_psum = psum;
                         }
                     }
-                    auto max_psums = max_psum * std::min(Kc, (int)K - kc);
-
-                    cycles->value[layer_it][n] += max_psums;
-                    dense_cycles->value[layer_it][n] += max_psums;
-                    idle_halo->value[layer_it][n] += max_psums * Ht * Wt * I * F;
-                    halo_transfers->value[layer_it][n] += tmp_halo_transfers;
                 }
+                auto max_psums = max_psum * std::min(Kc, (int)K - kc);
+
+                tile_partial.cycles += max_psums;
+                tile_partial.dense_cycles += max_psums;
+                partial_idle_halo[tile] = max_psums * Ht * Wt * I * F;
+                partial_halo_transfers[tile] = tmp_halo_transfers;
+            }
+
+            // Reduce the partial stats in tile order
+            for(int tile = 0; tile < num_tiles; tile++) {
+                int n = samples[tile / groups_per_sample];
+                const auto &tile_partial = partial_stats[tile];
+
+                cycles->value[layer_it][n] += tile_partial.cycles;
+                dense_cycles->value[layer_it][n] += tile_partial.dense_cycles;
+                mults->value[layer_it][n] += tile_partial.mults;
+                idle_bricks->value[layer_it][n] += tile_partial.idle_bricks;
+                idle_conflicts->value[layer_it][n] += tile_partial.idle_conflicts;
+                idle_pe->value[layer_it][n] += tile_partial.idle_pe;
+                weight_buff_reads->value[layer_it][n] += tile_partial.weight_buff_reads;
+                act_buff_reads->value[layer_it][n] += tile_partial.act_buff_reads;
+                accumulator_updates->value[layer_it][n] += tile_partial.accumulator_updates;
+                i_loop->value[layer_it][n] += tile_partial.i_loop;
+                f_loop->value[layer_it][n] += tile_partial.f_loop;
+                offchip_weight_reads->value[layer_it][n] += tile_partial.offchip_weight_reads;
+                idle_halo->value[layer_it][n] += partial_idle_halo[tile];
+                halo_transfers->value[layer_it][n] += partial_halo_transfers[tile];
+            }
+
+            for(int n : samples) {
                 total_mult_cycles->value[layer_it][n] = mults->value[layer_it][n] + idle_bricks->value[layer_it][n] +
                         idle_conflicts->value[layer_it][n] + idle_pe->value[layer_it][n] + idle_halo->value[layer_it][n];
             }
 
-
         }
 
         //Dump statistics
@@ -350,7 +414,9 @@ namespace core {
         header += "Output accumulator size: " + std::to_string(OUT_ACC_SIZE) + "\n";
         header += "Number of banks: " + std::to_string(BANKS) + "\n";
 
-        stats.dump_csv(network.getName(), network.getLayersName(), header, this->QUIET);
+        if (SHARD.count > 1) stats.dump_partial(network.getName(), network.getLayersName(), header, SHARD,
+                this->QUIET);
+        else stats.dump_csv(network.getName(), network.getLayersName(), header, this->QUIET);
 
     }
 
@@ -384,7 +450,7 @@ namespace core {
     }
 
     template <typename T>
-    void SCNN<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void SCNN<T>::process_tiles(const TilesData<T> &tiles_data) {
         throw std::runtime_error("SCNN simulation is not implemented by Simulator module");
     }
 
@@ -407,6 +473,14 @@ namespace core {
         else return this->network_width * this->network_width;
     }
 
+    template <typename T>
+    uint64_t SCNN<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t pairs = 0;
+        for (uint64_t i = 0; i < size; ++i)
+            pairs += wgt[i] != 0 && act[i] != 0;
+        return pairs * this->network_width * this->network_width;
+    }
+
     INITIALISE_DATA_TYPES(SCNN);
 
 }
\ No newline at end of file
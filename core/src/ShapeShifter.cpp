@@ -59,50 +59,71 @@ namespace core {
     }
 
     template <typename T>
-    void ShapeShifter<T>::process_pe(const BufferSet<T> &act_row, const BufferRow<T> &wgt_row, int window_idx,
+    void ShapeShifter<T>::process_pe(const BufferSlice<T> &act_row, const BufferRow<T> &wgt_row, int window_idx,
             int filter_idx, int lanes, int time, int &min_group_bit, int &max_group_bit, int act_blk) {
 
         auto shift = this->PE_WIDTH * act_blk;
         auto mask = ((1u << this->PE_WIDTH) - 1u) << shift;
 
-        for (int lane = 0; lane < lanes; ++lane) {
+        // The minimum and maximum bits of the lanes are the ones of their bitwise or
+        uint16_t group_bits = 0;
+        bool any_lane = false;
 
-            auto time_h = 0;
-            auto lane_d = lane;
-            if (!wgt_row.empty()) {
-                time_h = std::get<1>(wgt_row[filter_idx + lane]) - time;
-                lane_d = std::get<2>(wgt_row[filter_idx + lane]);
+        if (wgt_row.empty()) {
 
-                if (time_h < 0) continue;
+            if (lanes <= 0) return;
+            any_lane = true;
+
+            const T *values = act_row.row_values(0) + window_idx;
+            #pragma omp simd reduction(|:group_bits)
+            for (int lane = 0; lane < lanes; ++lane) {
+                uint16_t act_bits = (values[lane] & mask) >> shift;
+                if(this->signed_act && (act_bits & act_mask) != 0) {
+                    act_bits = act_bits ^ (act_mask - 1u + act_mask);
+                }
+                group_bits |= act_bits;
             }
 
-            auto act_bits = std::get<0>(act_row[time_h][window_idx + lane_d]);
-            act_bits = (act_bits & mask) >> shift;
+        } else {
 
-            if(this->signed_act && (act_bits & act_mask) != 0) {
-                act_bits = act_bits ^ (act_mask - 1u + act_mask);
-            }
+            for (int lane = 0; lane < lanes; ++lane) {
 
-            const auto &min_max_bits = minMax(act_bits);
+                auto time_h = wgt_row.times[filter_idx + lane] - time;
+                auto lane_d = wgt_row.lanes[filter_idx + lane];
 
-            auto min_bit = std::get<0>(min_max_bits);
-            auto max_bit = std::get<1>(min_max_bits);
+                if (time_h < 0) continue;
+
+                uint16_t act_bits = (act_row.value(time_h, window_idx + lane_d) & mask) >> shift;
+                if(this->signed_act && (act_bits & act_mask) != 0) {
+                    act_bits = act_bits ^ (act_mask - 1u + act_mask);
+                }
+                group_bits |= act_bits;
+                any_lane = true;
 
-            max_bit += this->signed_act;
+            }
 
-            if(min_bit < min_group_bit) min_group_bit = min_bit;
-            if(max_bit > max_group_bit) max_group_bit = max_bit;
+            if (!any_lane) return;
 
         }
 
+        const auto &min_max_bits = minMax(group_bits);
+
+        auto min_bit = std::get<0>(min_max_bits);
+        auto max_bit = std::get<1>(min_max_bits);
+
+        max_bit += this->signed_act;
+
+        if(min_bit < min_group_bit) min_group_bit = min_bit;
+        if(max_bit > max_group_bit) max_group_bit = max_bit;
+
     }
 
     template <typename T>
-    void ShapeShifter<T>::process_linear(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void ShapeShifter<T>::process_linear(const TilesData<T> &tiles_data) {
 
         auto max_tile_cycles = 0;
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -172,12 +193,12 @@ namespace core {
     }
 
     template <typename T>
-    void ShapeShifter<T>::process_mmul(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void ShapeShifter<T>::process_mmul(const TilesData<T> &tiles_data) {
 
         auto max_group_cycles = std::vector<uint64_t>(this->column_cycles.size(), 0);
 
-        for (int t = 0; t < tiles_data->data.size(); ++t) {
-            const auto &tile_data = tiles_data->data[t];
+        for (int t = 0; t < tiles_data.data.size(); ++t) {
+            const auto &tile_data = tiles_data.data[t];
 
             if (!tile_data.valid)
                 continue;
@@ -219,7 +240,7 @@ namespace core {
                 } // Act Spatial Composition
             } // Window
 
-            if (group_count < GROUP_SIZE) {
+            if (group_count < GROUP_SIZE && group < max_group_cycles.size()) {
                 auto cycles = MINOR_BIT ? min_act_bit > max_act_bit ? 1 + this->signed_act
                         : max_act_bit - min_act_bit + 1 : max_act_bit + 1;
 
@@ -266,7 +287,7 @@ namespace core {
     }
 
     template <typename T>
-    void ShapeShifter<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void ShapeShifter<T>::process_tiles(const TilesData<T> &tiles_data) {
         if (this->linear) process_linear(tiles_data);
         else process_mmul(tiles_data);
     }
@@ -306,6 +327,14 @@ namespace core {
         return act_width * this->network_width;
     }
 
+    template <typename T>
+    uint64_t ShapeShifter<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        uint64_t bits = 0;
+        for (uint64_t i = 0; i < size; ++i)
+            bits += ShapeShifter<T>::computeBits(act[i], wgt[i]);
+        return bits;
+    }
+
     template class ShapeShifter<uint16_t>;
 
 }
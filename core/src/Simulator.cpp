@@ -1,77 +1,169 @@
 
 #include <core/Simulator.h>
 
+#include <future>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace core {
 
     /* AUXILIARY FUNCTIONS */
 
+    /** Rows of the im2col panel of every thread */
+    const int GEMM_ROWS = 64;
+
+    /** Filters multiplied with the panel at once */
+    const int GEMM_FILTERS = 32;
+
+    /** Columns of the panel and the weights multiplied at once */
+    const int GEMM_COLUMNS = 256;
+
+    /** Multiply a panel of unrolled windows with the weights of a group of filters and accumulate the results
+     * @param output    Output values of every filter, one value per panel row (Updated)
+     * @param stride    Distance between the values of two filters in the output
+     * @param panel     Unrolled windows, one row per window
+     * @param rows      Number of rows of the panel
+     * @param weights   Weights of every filter unrolled in the same order as the windows
+     * @param filters   Filters of the group
+     * @param columns   Number of values of a window
+     */
+    template <typename T>
+    void blocked_gemm(double *output, uint64_t stride, const T *panel, int rows, const T *weights,
+            const std::vector<int> &filters, int columns) {
+
+        for (int f_blk = 0; f_blk < filters.size(); f_blk += GEMM_FILTERS) {
+            auto f_end = std::min(f_blk + GEMM_FILTERS, (int)filters.size());
+
+            for (int c_blk = 0; c_blk < columns; c_blk += GEMM_COLUMNS) {
+                auto c_end = std::min(c_blk + GEMM_COLUMNS, columns);
+
+                for (int f = f_blk; f < f_end; ++f) {
+                    auto filter = filters[f];
+                    const T *wgt_row = weights + (uint64_t)filter * columns;
+                    double *out_row = output + filter * stride;
+
+                    for (int r = 0; r < rows; ++r) {
+                        const T *act_row = panel + (uint64_t)r * columns;
+
+                        double sum = 0;
+                        #pragma omp simd reduction(+:sum)
+                        for (int c = c_blk; c < c_end; ++c)
+                            sum += act_row[c] * wgt_row[c];
+
+                        out_row[r] += sum;
+                    }
+                }
+            }
+        }
+    }
+
+    /** Check the output values of the simulation against a reference convolution
+     * The windows are unrolled (im2col) into a panel per thread and multiplied with the weights by blocks
+     * @param sim_output    Output values of the simulation
+     * @param act           Activations of the sample
+     * @param wgt           Weights of the layer
+     * @param Ox            Number of windows in the X dimension
+     * @param Oy            Number of windows in the Y dimension
+     * @param stride        Stride of the layer
+     * @param _3dim         Activations are 3D (RNN layers)
+     * @param diffy         Activations are the difference with the previous window in the X dimension
+     * @param threads       Number of threads of the reference convolution
+     */
     template <typename T>
     void check_result(const OutputTensor &sim_output, const std::shared_ptr<base::Array<T>> &act,
-            const std::shared_ptr<base::Array<T>> &wgt, uint64_t Ox, uint64_t Oy, int stride, bool _3dim, bool diffy) {
+            const std::shared_ptr<base::Array<T>> &wgt, uint64_t Ox, uint64_t Oy, int stride, bool _3dim, bool diffy,
+            int threads) {
 
         const std::vector<size_t> &act_shape = act->getShape();
         const std::vector<size_t> &wgt_shape = wgt->getShape();
 
         // Activations
-        auto R = _3dim ? act_shape[1] : 1;
+        int R = _3dim ? act_shape[1] : 1;
         auto act_channels = _3dim ? act_shape[2] : act_shape[1];
 
         // Weights
-        auto num_filters = wgt_shape[0];
-        auto wgt_channels = wgt_shape[1];
-        auto Kx = wgt_shape[2];
-        auto Ky = wgt_shape[3];
+        int num_filters = wgt_shape[0];
+        int wgt_channels = wgt_shape[1];
+        int Kx = wgt_shape[2];
+        int Ky = wgt_shape[3];
 
         auto groups = act_channels / wgt_channels;
         auto filters_per_group = num_filters / groups;
 
-        OutputTensor output = OutputTensor(num_filters, std::vector<std::vector<double>>(Ox,
-                std::vector<double>(Oy, 0)));
-
-        // Actual convolution
-        for (int r = 0; r < R; ++r) {
-
-            for (int m = 0; m < num_filters; ++m) {
-
-                // Two towers alexnet
-                int start_group = 0;
-                if (m >= filters_per_group)
-                    start_group = (int) wgt_channels;
+        // Group the filters by their first channel
+        std::map<int, std::vector<int>> channel_groups;
+        for (int m = 0; m < num_filters; ++m) {
 
-                // Fix for MobileNet
-                if (wgt_channels == 1 && act_channels != 1)
-                    start_group = m;
+            // Two towers alexnet
+            int start_group = 0;
+            if (m >= filters_per_group)
+                start_group = wgt_channels;
 
-                // Number of Windows
-                for (int x = 0; x < Ox; ++x) {
-                    for (int y = 0; y < Oy; ++y) {
+            // Fix for MobileNet
+            if (wgt_channels == 1 && act_channels != 1)
+                start_group = m;
 
-                        double sum = 0;
+            channel_groups[_3dim ? 0 : start_group].push_back(m);
+        }
 
-                        // Window dimension
-                        for (int j = 0; j < Ky; ++j) {
-                            for (int i = 0; i < Kx; ++i) {
-                                for (int k = 0; k < wgt_channels; ++k) {
-                                    auto x_window = stride * x;
-                                    auto y_window = stride * y;
+        // Weights unrolled in channel, X and Y order
+        int columns = wgt_channels * Kx * Ky;
+        std::vector<T> weights((uint64_t)num_filters * columns);
+        for (int m = 0; m < num_filters; ++m)
+            for (int k = 0; k < wgt_channels; ++k)
+                for (int i = 0; i < Kx; ++i)
+                    for (int j = 0; j < Ky; ++j)
+                        weights[(uint64_t)m * columns + (k * Kx + i) * Ky + j] = wgt->get(m, k, i, j);
+
+        // RNN layers accumulate the rows of the activations in a single window
+        int rows = _3dim ? R : Ox * Oy;
+        OutputTensor output = _3dim ? OutputTensor(num_filters, 1, rows) : OutputTensor(num_filters, Ox, Oy);
+
+        #pragma omp parallel for num_threads(threads) schedule(dynamic)
+        for (int r_blk = 0; r_blk < rows; r_blk += GEMM_ROWS) {
+            auto panel_rows = std::min(GEMM_ROWS, rows - r_blk);
+            std::vector<T> panel((uint64_t)panel_rows * columns);
+
+            for (const auto &channel_group : channel_groups) {
+                auto start_group = channel_group.first;
+
+                // Unroll the windows of the block
+                for (int r = 0; r < panel_rows; ++r) {
+                    T *panel_row = panel.data() + (uint64_t)r * columns;
+
+                    if (_3dim) {
+                        for (int k = 0; k < wgt_channels; ++k)
+                            for (int i = 0; i < Kx * Ky; ++i)
+                                panel_row[k * Kx * Ky + i] = act->get(0, r_blk + r, k);
+                        continue;
+                    }
 
-                                    auto act_bits = _3dim ? act->get(0, r, k) :
-                                            act->get(0, start_group + k, x_window + i, y_window + j);
+                    int x = (r_blk + r) / Oy;
+                    int y = (r_blk + r) % Oy;
+                    auto x_window = stride * x;
+                    auto y_window = stride * y;
 
-                                    if (diffy && !_3dim) {
-                                        auto prev_act_bits = (x_window - stride < 0) ? 0 :
-                                                act->get(0, start_group + k, x_window + i - stride, y_window + j);
-                                        act_bits = (short)act_bits - (short)prev_act_bits;
-                                    }
+                    for (int k = 0; k < wgt_channels; ++k) {
+                        for (int i = 0; i < Kx; ++i) {
+                            for (int j = 0; j < Ky; ++j) {
+                                auto act_bits = act->get(0, start_group + k, x_window + i, y_window + j);
 
-                                    sum += act_bits * wgt->get(m, k, i, j);
+                                if (diffy) {
+                                    auto prev_act_bits = (x_window - stride < 0) ? 0 :
+                                            act->get(0, start_group + k, x_window + i - stride, y_window + j);
+                                    act_bits = (short)act_bits - (short)prev_act_bits;
                                 }
+
+                                panel_row[(k * Kx + i) * Ky + j] = act_bits;
                             }
                         }
-
-                        output[m][x][y] += sum;
                     }
                 }
+
+                blocked_gemm(output.filter_values(0) + r_blk, rows, panel.data(), panel_rows, weights.data(),
+                        channel_group.second, columns);
             }
         }
 
@@ -79,8 +171,12 @@ namespace core {
         for (int ch = 0; ch < num_filters; ++ch) {
             for (int x = 0; x < Ox; ++x) {
                 for (int y = 0; y < Oy; ++y) {
-                    auto actual_value = output[ch][x][y];
-                    auto sim_value = sim_output[ch][x][y];
+                    double actual_value = 0;
+                    if (_3dim) {
+                        for (int r = 0; r < R; ++r)
+                            actual_value += output(ch, 0, r);
+                    } else actual_value = output(ch, x, y);
+                    auto sim_value = sim_output(ch, x, y);
                     auto error = (actual_value - sim_value) / sim_value;
                     if (abs(error) > 1e-10)
                         throw std::runtime_error("Wrong value.");
@@ -89,6 +185,15 @@ namespace core {
         }
     }
 
+    /** Wait for a functional check running in the background
+     * @param check     Background check, ignored if there is none
+     * @return          Failure of the check, empty if correct
+     */
+    std::string wait_check(std::future<std::string> &check) {
+        if (!check.valid()) return "";
+        return check.get();
+    }
+
     template <typename T>
     void calculate_output(OutputTensor &output, const TilesData<T> &tiles_data) {
 
@@ -108,15 +213,15 @@ namespace core {
 
                     for (int lane = 0; lane < tile_data.lanes; ++lane) {
 
-                        auto wgt_bits = std::get<0>(tile_data.wgt_row[filter_idx + lane]);
-                        auto time_h = (std::get<1>(tile_data.wgt_row[filter_idx + lane]) - tile_data.time);
-                        auto lane_d = std::get<2>(tile_data.wgt_row[filter_idx + lane]);
+                        auto wgt_bits = tile_data.wgt_row.values[filter_idx + lane];
+                        auto time_h = (tile_data.wgt_row.times[filter_idx + lane] - tile_data.time);
+                        auto lane_d = tile_data.wgt_row.lanes[filter_idx + lane];
 
                         if (time_h < 0) continue;
 
-                        auto act_bits = std::get<0>(tile_data.act_row[time_h][window_idx + lane_d]);
+                        auto act_bits = tile_data.act_row.value(time_h, window_idx + lane_d);
 
-                        output[filter][x_window][y_window] += act_bits * wgt_bits;
+                        output(filter, x_window, y_window) += act_bits * wgt_bits;
 
                     } // Multiply 16 weights and 16 activations values
                 } // Filter
@@ -125,12 +230,96 @@ namespace core {
 
     }
 
+    template <typename T>
+    void Simulator<T>::convert_layer(const base::Layer<T> &layer, const std::shared_ptr<Architecture<T>> &arch,
+            base::Array<T> &act, base::Array<T> &wgt) {
+
+        bool fc = layer.getType() == "InnerProduct";
+
+        act = layer.getActivations();
+        arch->dataConversion(act);
+        if (fc && act.getDimensions() == 4) act.reshape_to_2D();
+        if (act.getDimensions() == 2) act.reshape_to_4D();
+
+        wgt = layer.getWeights();
+        arch->dataConversion(wgt);
+        if (wgt.getDimensions() == 2) wgt.reshape_to_4D();
+    }
+
+    template <typename T>
+    int Simulator<T>::read_layer(const base::Layer<T> &layer, const base::Array<T> &layer_act,
+            const base::Array<T> &layer_wgt, int sample, std::shared_ptr<base::Array<T>> &act,
+            std::shared_ptr<base::Array<T>> &wgt) {
+
+        bool conv = layer.getType() == "Convolution";
+
+        act = std::make_shared<base::Array<T>>(layer_act);
+        act->get_sample(sample);
+
+        wgt = std::make_shared<base::Array<T>>(layer_wgt);
+
+        int padding = layer.getPadding();
+        int stride = layer.getStride();
+
+        if (conv) act->zero_pad(padding);
+
+        if (act->getShape()[1] == 3 && stride > 1) {
+            act->reshape_first_layer_act(stride);
+            wgt->reshape_first_layer_wgt(stride);
+            stride = 1;
+        }
+
+        return stride;
+    }
+
+    template <typename T>
+    int Simulator<T>::layer_shapes(const base::Layer<T> &layer, const base::Array<T> &layer_act,
+            const base::Array<T> &layer_wgt, std::vector<size_t> &act_shape, std::vector<size_t> &wgt_shape) {
+
+        bool conv = layer.getType() == "Convolution";
+
+        act_shape = layer_act.getShape();
+        act_shape[0] = 1;
+
+        wgt_shape = layer_wgt.getShape();
+
+        int padding = layer.getPadding();
+        int stride = layer.getStride();
+
+        if (conv && padding > 0) {
+            act_shape[2] += 2 * padding;
+            act_shape[3] += 2 * padding;
+        }
+
+        if (act_shape[1] == 3 && stride > 1) {
+            if (act_shape.size() == 4) {
+                // Both sizes follow the X dimension, as in reshape_first_layer_act
+                auto Nx = act_shape[2];
+                act_shape[1] = (size_t)((uint16_t)act_shape[1] * stride * stride);
+                act_shape[2] = (uint16_t)ceil(Nx / (double)stride);
+                act_shape[3] = (uint16_t)ceil(Nx / (double)stride);
+            }
+            if (wgt_shape.size() == 4 && wgt_shape[1] == 3) {
+                wgt_shape[1] = (size_t)((uint16_t)wgt_shape[1] * stride * stride);
+                wgt_shape[2] = (uint16_t)ceil(wgt_shape[2] / (double)stride);
+                wgt_shape[3] = (uint16_t)ceil(wgt_shape[3] / (double)stride);
+            }
+            stride = 1;
+        }
+
+        return stride;
+    }
+
     /* CYCLES */
 
     template <typename T>
-    void Simulator<T>::run(const base::Network<T> &network, const std::shared_ptr<Control<T>> &control) {
+    void Simulator<T>::run(const base::Network<T> &network, const std::vector<std::shared_ptr<Control<T>>> &controls) {
+
+        if (controls.empty())
+            throw std::runtime_error("No control stack provided for the simulation.");
 
-        // Get components from control
+        // Get components from the first control for the outputs
+        const auto &control = controls.front();
         auto dram = control->getDram();
         auto gbuffer = control->getGbuffer();
         auto abuffer = control->getAbuffer();
@@ -149,6 +338,18 @@ namespace core {
         auto batch_size = this->FAST_MODE ? 1 : network.getBatchSize();
         sys::Stats stats = sys::Stats(network.getNumLayers(), batch_size, filename);
 
+        auto num_layers = network.getNumLayers();
+
+        // Layers and samples simulated by this shard
+        std::vector<uint64_t> items;
+        for (uint64_t item = 0; item < batch_size * num_layers; ++item) {
+            if (SHARD.owns(item)) items.push_back(item);
+        }
+
+        uint64_t max_threads = std::min(std::min((uint64_t)N_THREADS, (uint64_t)controls.size()),
+                (uint64_t)items.size());
+        max_threads = std::max(max_threads, (uint64_t)1);
+
         // Time stats
         auto cycles = stats.register_uint_t("cycles", 0, sys::AverageTotal);
         auto compute_cycles = stats.register_uint_t("compute_cycles", 0, sys::AverageTotal);
@@ -217,40 +418,77 @@ namespace core {
         auto act_precision = stats.register_uint_t("activations precision", 0, sys::Average);
         auto wgt_precision = stats.register_uint_t("weights precision", 0, sys::Average);
 
-        // Iterate over the samples
-        for(auto sample = 0; sample < batch_size; ++sample) {
+        // Convert the data of every layer once, the samples are views of the converted batch
+        auto layer_acts = std::vector<base::Array<T>>(num_layers);
+        auto layer_wgts = std::vector<base::Array<T>>(num_layers);
+        #pragma omp parallel for num_threads(max_threads) schedule(dynamic)
+        for (int layer_it = 0; layer_it < num_layers; ++layer_it) {
+            convert_layer(network.getLayers()[layer_it], arch, layer_acts[layer_it], layer_wgts[layer_it]);
+        }
+
+        // Pre-pass: layers only depend on the previous ones through the state carried by the control, which
+        // depends on the layer shapes and the buffer sizes but not on the simulation itself
+        auto layer_states = std::vector<typename Control<T>::LayerState>(num_layers);
+        for (int layer_it = 0; layer_it + 1 < num_layers; ++layer_it) {
+            const base::Layer<T> &layer = network.getLayers()[layer_it];
+            bool rnn = layer.getType() == "RNN";
+            bool fc = layer.getType() == "InnerProduct";
+
+            std::vector<size_t> act_shape, wgt_shape;
+            int stride = layer_shapes(layer, layer_acts[layer_it], layer_wgts[layer_it], act_shape, wgt_shape);
+            layer_states[layer_it + 1] = control->next_layer_state(layer_states[layer_it], act_shape, wgt_shape,
+                    layer.getActPrecision(), layer.getWgtPrecision(), fc || rnn, rnn, stride);
+        }
 
-            // Iterate over the layers
-            for (auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
+        // Errors raised inside the parallel region are rethrown once all the threads are done
+        std::exception_ptr error = nullptr;
+
+        // Functional checks run in the background, at most one per thread, and are reported at the end
+        // The threads left by the simulation loop are shared among the checks in flight
+        std::vector<std::future<std::string>> checks(max_threads);
+        std::vector<std::string> check_errors;
+        int check_threads = (int)std::max((uint64_t)1, N_THREADS / max_threads);
+
+        // Iterate over the layers of every sample, round-robin so every thread simulates the same layers run after run
+        #pragma omp parallel for num_threads(max_threads) schedule(static, 1)
+        for (int it = 0; it < items.size(); ++it) {
+            int sample = items[it] / num_layers;
+            int layer_it = items[it] % num_layers;
+
+            // Each thread simulates with its own control stack
+            #ifdef _OPENMP
+            int thread = omp_get_thread_num();
+            #else
+            int thread = 0;
+            #endif
+            const auto &control = controls[thread];
+
+            try {
+
+                auto dram = control->getDram();
+                auto gbuffer = control->getGbuffer();
+                auto abuffer = control->getAbuffer();
+                auto pbuffer = control->getPbuffer();
+                auto wbuffer = control->getWbuffer();
+                auto obuffer = control->getObuffer();
+                auto composer = control->getComposer();
+                auto ppu = control->getPPU();
+                auto arch = control->getArch();
+
+                // Every layer starts from the state computed in the pre-pass and with an idle DRAM, whatever the
+                // thread or the shard that simulates it
+                control->setLayerState(layer_states[layer_it]);
+                dram->reset();
 
                 const base::Layer<T> &layer = network.getLayers()[layer_it];
-                bool conv = layer.getType() == "Convolution";
                 bool rnn = layer.getType() == "RNN";
                 bool fc = layer.getType() == "InnerProduct";
 
                 if (!QUIET) printf("Simulating sample: %d/%lu for layer: %s\n", sample + 1, batch_size,
                         layer.getName().c_str());
 
-                auto act = std::make_shared<base::Array<T>>(layer.getActivations());
-                arch->dataConversion(*act);
-                if (fc && act->getDimensions() == 4) act->reshape_to_2D();
-                if (act->getDimensions() == 2) act->reshape_to_4D();
-                act->get_sample(sample);
-
-                auto wgt = std::make_shared<base::Array<T>>(layer.getWeights());
-                arch->dataConversion(*wgt);
-                if (wgt->getDimensions() == 2) wgt->reshape_to_4D();
-
-                int padding = layer.getPadding();
-                int stride = layer.getStride();
-
-                if (conv) act->zero_pad(padding);
-
-                if (act->getShape()[1] == 3 && stride > 1) {
-                    act->reshape_first_layer_act(stride);
-                    wgt->reshape_first_layer_wgt(stride);
-                    stride = 1;
-                }
+                std::shared_ptr<base::Array<T>> act, wgt;
+                int stride = read_layer(layer, layer_acts[layer_it], layer_wgts[layer_it], sample, act, wgt);
 
                 const std::vector<size_t> &act_shape = act->getShape();
                 const std::vector<size_t> &wgt_shape = wgt->getShape();
@@ -274,23 +512,24 @@ namespace core {
                 auto act_prec = layer.getActPrecision();
                 auto wgt_prec = layer.getWgtPrecision();
                 control->configure_layer(act, wgt, act_prec, wgt_prec, fc || rnn, rnn, stride);
+                assert(layer_it + 1 == num_layers || control->getLayerState() == layer_states[layer_it + 1]);
 
-                OutputTensor sim_output = OutputTensor(num_filters, std::vector<std::vector<double>>(Ox,
-                        std::vector<double>(Oy, 0)));
+                auto sim_output = this->CHECK ? OutputTensor(num_filters, Ox, Oy) : OutputTensor();
 
-                Pipeline<T> pipeline = Pipeline<T>(Stage::Last + 1);
+                Pipeline<T> pipeline = Pipeline<T>(Stage::Last + 1, arch->getTiles());
                 do {
 
-                    gbuffer->evict_data(control->getIfEvictAct(), control->getIfEvictOut(), control->getIfEvictWgt());
+                    gbuffer->evict_data(control->getIfEvictAct(), control->getIfEvictOut(),
+                            control->getIfEvictWgt());
                     dram->read_data(control->getReadActAddresses(), control->getReadPsumAddresses(),
                             control->getReadWgtAddresses());
 
-                    auto init_data = TilesData<T>(arch->getTiles());
+                    auto &init_data = pipeline.next_data();
                     bool still_data = control->still_on_chip_data(init_data);
                     if (still_data) {
                         if (this->CHECK) calculate_output(sim_output, init_data);
                         dram->read_request(init_data, control->getIfLayerActOnChip());
-                        pipeline.fetch_data(init_data);
+                        pipeline.fetch_data();
                     }
 
                     while(still_data || !pipeline.isEmpty()) {
@@ -300,7 +539,8 @@ namespace core {
                             pipeline.end_stage(WRITEBACK_III);
                         }
 
-                        if (pipeline.isValid(WRITEBACK_II) && pipeline.isFree(WRITEBACK_III) && obuffer->write_done()) {
+                        if (pipeline.isValid(WRITEBACK_II) && pipeline.isFree(WRITEBACK_III) &&
+                                obuffer->write_done()) {
                             const auto &tiles_data = pipeline.getData(WRITEBACK_II);
                             gbuffer->write_request(tiles_data);
                             pipeline.move_stage(WRITEBACK_II);
@@ -316,44 +556,45 @@ namespace core {
 
                         if (pipeline.isValid(EXECUTION) && obuffer->isFree() && abuffer->data_ready() &&
                                 pbuffer->data_ready() && wbuffer->data_ready() && arch->ready()) {
-                            const auto &tiles_data = pipeline.getData(EXECUTION);
+                            auto &tiles_data = pipeline.getData(EXECUTION);
                             arch->process_tiles(tiles_data);
-                            abuffer->erase(tiles_data->read_act);
-                            pbuffer->erase(tiles_data->read_psum);
-                            wbuffer->erase(tiles_data->read_wgt);
+                            abuffer->erase(tiles_data.read_act);
+                            pbuffer->erase(tiles_data.read_psum);
+                            wbuffer->erase(tiles_data.read_wgt);
                             if (control->check_if_write_output(tiles_data)) pipeline.move_stage(EXECUTION);
                             else pipeline.end_stage(EXECUTION);
                         }
 
                         if (pipeline.isValid(MEMORY_II) && pipeline.isFree(EXECUTION) && gbuffer->data_ready()) {
-                            const auto &tiles_data = pipeline.getData(MEMORY_II);
-                            abuffer->read_request(tiles_data->read_act);
-                            pbuffer->read_request(tiles_data->read_psum);
-                            wbuffer->read_request(tiles_data->read_wgt);
+                            auto &tiles_data = pipeline.getData(MEMORY_II);
+                            abuffer->read_request(tiles_data.read_act);
+                            pbuffer->read_request(tiles_data.read_psum);
+                            wbuffer->read_request(tiles_data.read_wgt);
                             pipeline.move_stage(MEMORY_II);
                         }
 
-                        if (pipeline.isValid(MEMORY_I) && dram->data_ready() && abuffer->isFree() && pbuffer->isFree()
-                                && wbuffer->isFree()) {
-                            const auto &tiles_data = pipeline.getData(MEMORY_I);
-                            gbuffer->act_read_request(tiles_data, control->getIfLayerActOnChip(), tiles_data->read_act);
-                            gbuffer->psum_read_request(tiles_data, tiles_data->read_psum);
-                            gbuffer->wgt_read_request(tiles_data, tiles_data->read_wgt);
-                            abuffer->insert(tiles_data->read_act);
-                            pbuffer->insert(tiles_data->read_psum);
-                            wbuffer->insert(tiles_data->read_wgt);
+                        if (pipeline.isValid(MEMORY_I) && dram->data_ready() && abuffer->isFree() &&
+                                pbuffer->isFree() && wbuffer->isFree()) {
+                            auto &tiles_data = pipeline.getData(MEMORY_I);
+                            gbuffer->act_read_request(tiles_data, control->getIfLayerActOnChip(),
+                                    tiles_data.read_act);
+                            gbuffer->psum_read_request(tiles_data, tiles_data.read_psum);
+                            gbuffer->wgt_read_request(tiles_data, tiles_data.read_wgt);
+                            abuffer->insert(tiles_data.read_act);
+                            pbuffer->insert(tiles_data.read_psum);
+                            wbuffer->insert(tiles_data.read_wgt);
                             pipeline.move_stage(MEMORY_I);
                         }
 
                         control->cycle();
 
                         if (pipeline.isFree(MEMORY_I) && still_data) {
-                            auto next_data = TilesData<T>(arch->getTiles());
+                            auto &next_data = pipeline.next_data();
                             still_data = control->still_on_chip_data(next_data);
                             if (still_data) {
                                 if (this->CHECK) calculate_output(sim_output, next_data);
                                 dram->read_request(next_data, control->getIfLayerActOnChip());
-                                pipeline.fetch_data(next_data);
+                                pipeline.fetch_data();
                             }
                         }
 
@@ -364,7 +605,28 @@ namespace core {
 
                 } while(control->still_off_chip_data());
 
-                if (CHECK) check_result(sim_output, act, wgt, Ox, Oy, stride, rnn, arch->diffy());
+                if (CHECK) {
+
+                    // Bound the snapshots in flight: wait for the previous check of this thread
+                    auto check_error = wait_check(checks[thread]);
+                    if (!check_error.empty()) {
+                        #pragma omp critical
+                        check_errors.push_back(check_error);
+                    }
+
+                    // The arrays read for the layer are not modified anymore, sharing them is a snapshot
+                    auto diffy = arch->diffy();
+                    auto check_name = layer.getName() + " sample " + std::to_string(sample + 1);
+                    checks[thread] = std::async(std::launch::async, [sim_output = std::move(sim_output), act, wgt,
+                            Ox, Oy, stride, rnn, diffy, check_name, check_threads]() -> std::string {
+                        try {
+                            check_result(sim_output, act, wgt, Ox, Oy, stride, rnn, diffy, check_threads);
+                        } catch (std::exception &exception) {
+                            return check_name + ": " + exception.what();
+                        }
+                        return "";
+                    });
+                }
 
                 // Dump stats
                 cycles->value[layer_it][sample] = control->getCycles();
@@ -396,10 +658,27 @@ namespace core {
                 act_precision->value[layer_it][sample] = act_prec;
                 wgt_precision->value[layer_it][sample] = wgt_prec;
 
-            } // Layer
+            } catch (...) {
+                #pragma omp critical
+                if (error == nullptr) error = std::current_exception();
+            }
 
         } // Sample
 
+        for (auto &check : checks) {
+            auto check_error = wait_check(check);
+            if (!check_error.empty()) check_errors.push_back(check_error);
+        }
+
+        if (error != nullptr) std::rethrow_exception(error);
+
+        if (!check_errors.empty()) {
+            std::sort(check_errors.begin(), check_errors.end());
+            std::string message = "Functional check failed for " + std::to_string(check_errors.size()) + " layers";
+            for (const auto &check_error : check_errors) message += "\n    " + check_error;
+            throw std::runtime_error(message);
+        }
+
         //Dump statistics
         std::string header = arch->name() + " Number of Cycles for " + network.getName() + "\n";
         header += "Dataflow: " + control->dataflow() + "\n";
@@ -413,7 +692,8 @@ namespace core {
         header += "--> Post-Processing Unit: \n" + ppu->header();
         header += "--> Architecture: \n" + arch->header();
 
-        stats.dump_csv(network.getName(), network.getLayersName(), header, QUIET);
+        if (SHARD.count > 1) stats.dump_partial(network.getName(), network.getLayersName(), header, SHARD, QUIET);
+        else stats.dump_csv(network.getName(), network.getLayersName(), header, QUIET);
     }
 
     /* POTENTIALS */
@@ -444,21 +724,24 @@ namespace core {
             bool rnn = layer.getType() == "RNN";
             bool fc = layer.getType() == "InnerProduct";
 
-            if (!QUIET) std::cout << "Simulating layer: " << layer.getName() << std::endl;
+            // Samples of the layer calculated by this shard
+            std::vector<int> samples;
+            uint64_t layer_batch = FAST_MODE ? 1 : layer.getActivations().getShape()[0];
+            for (int n = 0; n < layer_batch; ++n) {
+                if (SHARD.owns(n * network.getNumLayers() + layer_it)) samples.push_back(n);
+            }
+            if (samples.empty()) continue;
 
-            base::Array<T> act = layer.getActivations();
-            arch->dataConversion(act);
-            if (fc && act.getDimensions() == 4) act.reshape_to_2D();
-            if (act.getDimensions() == 2) act.reshape_to_4D();
+            if (!QUIET) std::cout << "Simulating layer: " << layer.getName() << std::endl;
 
-            base::Array<T> wgt = layer.getWeights();
-            arch->dataConversion(wgt);
-            if (wgt.getDimensions() == 2) wgt.reshape_to_4D();
+            base::Array<T> act, wgt;
+            convert_layer(layer, arch, act, wgt);
 
             int padding = layer.getPadding();
             int stride = layer.getStride();
 
             if (conv) act.zero_pad(padding);
+            act.materialize();
 
             const std::vector<size_t> &act_shape = act.getShape();
             const std::vector<size_t> &wgt_shape = wgt.getShape();
@@ -500,14 +783,37 @@ namespace core {
             arch->configure_layer(act_prec, wgt_prec, 1, 1, network_width, act.isSigned(), wgt.isSigned(),
                     fc || rnn, arch->getColumns());
 
-            for(int n = 0; n < batch_size; ++n) {
+            // Inner loops read the buffers directly
+            const T *act_data = act.getData();
+            const auto &act_strides = act.getStrides();
+            const T *wgt_data = wgt.getData();
+            const auto &wgt_strides = wgt.getStrides();
 
-                // Stats
-                uint64_t bit_counter = 0;
+            // Weights of every filter packed in the same order the activations are gathered
+            auto dot_size = conv ? Kx * Ky * wgt_channels : wgt_channels;
+            auto wgt_packed = std::vector<T>(num_filters * dot_size);
+            for (int m = 0; m < num_filters; ++m) {
+                auto idx = m * dot_size;
+                for (int i = 0; i < Kx; ++i)
+                    for (int j = 0; j < Ky; ++j)
+                        for (int k = 0; k < wgt_channels; ++k)
+                            wgt_packed[idx++] = wgt_data[m * wgt_strides[0] + k * wgt_strides[1] +
+                                    i * wgt_strides[2] + j];
+            }
+
+            // Split by sample and output channel, every pair accumulates its own counter
+            auto filter_bits = std::vector<uint64_t>(batch_size * num_filters, 0);
+
+            #pragma omp parallel for collapse(2) num_threads(N_THREADS) schedule(dynamic)
+            for (int s = 0; s < samples.size(); ++s) {
+                for (int m = 0; m < num_filters; ++m) {
 
-                if (conv) {
+                    int n = samples[s];
+                    uint64_t bit_counter = 0;
+                    auto act_packed = std::vector<T>(dot_size);
+                    const T *wgt_row = &wgt_packed[m * dot_size];
 
-                    for(int m = 0; m < num_filters; ++m) {
+                    if (conv) {
 
                         // Two towers alexnet
                         int start_group = 0;
@@ -520,32 +826,38 @@ namespace core {
 
                         for(int x = 0; x < Ox; ++x) {
                             for(int y = 0; y < Oy; ++y) {
-                                for (int i = 0; i < Kx; ++i) {
-                                    for (int j = 0; j < Ky; ++j) {
-                                        for (int k = 0; k < wgt_channels; ++k) {
-                                            T act_bits = act.get(n, start_group + k, stride * x + i, stride * y + j);
-                                            T wgt_bits = wgt.get(m, k, i, j);
-                                            bit_counter += arch->computeBits(act_bits, wgt_bits);
-                                        }
-                                    }
-                                }
+                                const T *window = act_data + n * act_strides[0] + start_group * act_strides[1] +
+                                        stride * x * act_strides[2] + stride * y;
+                                auto idx = 0;
+                                for (int i = 0; i < Kx; ++i)
+                                    for (int j = 0; j < Ky; ++j)
+                                        for (int k = 0; k < wgt_channels; ++k)
+                                            act_packed[idx++] = window[k * act_strides[1] + i * act_strides[2] + j];
+                                bit_counter += arch->computeBits(act_packed.data(), wgt_row, dot_size);
                             }
                         }
-                    }
 
-                } else {
+                    } else {
 
-                    for (int r = 0; r < R; ++r) {
-                        for (int m = 0; m < num_filters; ++m) {
-                            for (int k = 0; k < wgt_channels; ++k) {
-                                T act_bits = rnn ? act.get(n, r, k) : act.get(n, k);
-                                T wgt_bits = wgt.get(m, k);
-                                bit_counter += arch->computeBits(act_bits, wgt_bits);
-                            }
+                        // The channels of a recurrence, or of a fully connected sample, are contiguous
+                        for (int r = 0; r < R; ++r) {
+                            const T *row = act_data + n * act_strides[0] + (rnn ? r * act_strides[1] : 0);
+                            std::copy(row, row + wgt_channels, act_packed.begin());
+                            bit_counter += arch->computeBits(act_packed.data(), wgt_row, dot_size);
                         }
+
                     }
 
+                    filter_bits[n * num_filters + m] = bit_counter;
                 }
+            }
+
+            for (int n : samples) {
+
+                // Stats
+                uint64_t bit_counter = 0;
+                for (int m = 0; m < num_filters; ++m)
+                    bit_counter += filter_bits[n * num_filters + m];
 
                 bit_mult->value[layer_it][n] = bit_counter;
                 max_bit_mult->value[layer_it][n] = max_bit_counter;
@@ -558,20 +870,24 @@ namespace core {
                 wgt_precision->value[layer_it][n] = layer.getWgtPrecision();
             }
 
+        }
+
+        for(auto layer_it = 0; layer_it < network.getNumLayers(); ++layer_it) {
             work_reduction->special_value_vector.push_back(100 - (sys::get_total(bit_mult->value[layer_it]) /
                     (double)sys::get_total(max_bit_mult->value[layer_it]) * 100.));
             speedup->special_value_vector.push_back(sys::get_total(max_bit_mult->value[layer_it]) /
                     (double)(sys::get_total(bit_mult->value[layer_it])));
-
         }
 
-        work_reduction->special_value = 100 - (sys::get_total(bit_mult->value) /
-                (double)sys::get_total(max_bit_mult->value) * 100.);
-        speedup->special_value = sys::get_total(max_bit_mult->value) / (double)(sys::get_total(bit_mult->value));
+        // Network values from the totals of all the layers and samples, also once the shards are merged
+        stats.set_special_ratio(work_reduction, bit_mult, max_bit_mult, 100, -100.);
+        stats.set_special_ratio(speedup, max_bit_mult, bit_mult, 0, 1);
 
         //Dump statistics
-        std::string header = arch->name() + " Potentials/Work Reduction for " + network.getName() + "\n";
-        stats.dump_csv(network.getName(), network.getLayersName(), header + arch->header_pot(), QUIET);
+        std::string header = arch->name() + " Potentials/Work Reduction for " + network.getName() + "\n" +
+                arch->header_pot();
+        if (SHARD.count > 1) stats.dump_partial(network.getName(), network.getLayersName(), header, SHARD, QUIET);
+        else stats.dump_csv(network.getName(), network.getLayersName(), header, QUIET);
 
     }
 
@@ -28,7 +28,7 @@ namespace core {
     }
 
     template <typename T>
-    void Stripes<T>::process_tiles(const std::shared_ptr<TilesData<T>> &tiles_data) {
+    void Stripes<T>::process_tiles(const TilesData<T> &tiles_data) {
 
         auto process_time = std::min(this->act_prec, (int)this->PE_WIDTH);
         if (this->linear) {
@@ -53,7 +53,7 @@ namespace core {
 
         }
 
-        for (const auto &tile_data : tiles_data->data) {
+        for (const auto &tile_data : tiles_data.data) {
 
             if (!tile_data.valid)
                 continue;
@@ -90,6 +90,11 @@ namespace core {
         return this->act_prec * this->network_width;
     }
 
+    template <typename T>
+    uint64_t Stripes<T>::computeBits(const T *act, const T *wgt, uint64_t size) {
+        return size * this->act_prec * this->network_width;
+    }
+
     template class Stripes<uint16_t>;
 
 }
@@ -52,7 +52,7 @@ namespace core {
         return booth_encoding;
     }
 
-    std::vector<uint16_t> generateBoothEncodingTable(const int MAX_VALUES = 32768) {
+    std::vector<uint16_t> generateBoothEncodingTable(const int MAX_VALUES = 65536) {
         std::vector<uint16_t> booth_table ((unsigned)MAX_VALUES, 0);
         for(int n = 0; n < MAX_VALUES; n++)
             booth_table[n] = generateBoothEncodingEntry((uint16_t)n);
@@ -64,7 +64,7 @@ namespace core {
         return booth_table[value];
     }
 
-    std::vector<uint8_t> generateEffectualBitsTable(const int MAX_VALUES = 65535) {
+    std::vector<uint8_t> generateEffectualBitsTable(const int MAX_VALUES = 65536) {
         std::vector<uint8_t> effectual_bits_table ((unsigned)MAX_VALUES, 0);
         for(int n = 0; n < MAX_VALUES; n++) {
 
@@ -85,7 +85,7 @@ namespace core {
         return effectual_bits_table[value];
     }
 
-    std::vector<std::tuple<uint8_t,uint8_t>> generateMinMaxTable(const int MAX_VALUES = 32768) {
+    std::vector<std::tuple<uint8_t,uint8_t>> generateMinMaxTable(const int MAX_VALUES = 65536) {
         std::vector<std::tuple<uint8_t,uint8_t>> min_max_table ((unsigned)MAX_VALUES, std::tuple<uint8_t,uint8_t>());
         min_max_table[0] = {16,0};
         for(int n = 1; n < MAX_VALUES; n++) {
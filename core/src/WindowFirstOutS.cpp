@@ -137,162 +137,188 @@ namespace core {
         auto last_act_blk = (uint32_t)ceil(act_channels / (double)this->dram->getActValuesPerBlock());
         auto blks_per_window = (uint32_t)ceil(Ky * Kx * act_channels / (double)this->dram->getActValuesPerBlock());
 
-        bool next_evict_out = false;
-        auto next_out_address = this->next_act_address;
+        graph.act_policy = act_policy;
+        graph.wgt_policy = wgt_policy;
+        graph.window_steps = std::move(window_steps);
+        graph.filter_steps = filter_steps;
+        graph.filter_sets_per_step = filter_sets_per_step;
+        graph.total_filter_sets = total_filter_sets;
+        graph.time_steps = time_steps;
+        graph.max_time_per_step = max_time_per_step;
+        graph.last_act_blk = last_act_blk;
+        graph.blks_per_window = blks_per_window;
+        graph.nodes = graph.window_steps.size() * filter_steps * time_steps;
+        graph.next_node = 0;
+        graph.next_evict_out = false;
+        graph.next_out_address = this->next_act_address;
 
-        this->on_chip_graph = std::vector<std::shared_ptr<typename Control<T>::Node>>();
-
-        for (int wstep = 0; wstep < window_steps.size(); ++wstep) {
+    }
 
-            auto start_window = window_steps[wstep].front() * this->EF_COLUMNS;
-            auto total_windows = std::min(window_steps[wstep].size() * this->EF_COLUMNS,
-                    (uint64_t)(num_windows - start_window));
-            auto end_window = start_window + total_windows;
+    template <typename T>
+    void WindowFirstOutS<T>::generate_node_conv_layer(const std::shared_ptr<NodeOutS> &node) {
 
-            for(int fstep = 0; fstep < filter_steps; ++fstep) {
+        const std::vector<size_t> &act_shape = this->act->getShape();
+        const std::vector<size_t> &wgt_shape = this->wgt->getShape();
 
-                auto start_filter_set = fstep * filter_sets_per_step;
-                auto filter_per_set = std::min(filter_sets_per_step, total_filter_sets - start_filter_set);
-                auto end_filter_set = start_filter_set + filter_per_set;
+        auto Nx = act_shape[2];
+        auto Ny = act_shape[3];
 
-                auto start_filter_subset = fstep * filter_sets_per_step * this->arch->getTiles();
-                auto filter_per_subset = std::min(filter_sets_per_step * this->arch->getTiles(),
-                        this->filter_sets - start_filter_subset);
-                auto end_filter_subset = start_filter_subset + filter_per_subset;
+        auto num_filters = wgt_shape[0];
 
-                auto start_filter = fstep * filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS;
-                auto total_filters = std::min(filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS,
-                        (uint32_t)(num_filters - start_filter));
+        auto num_windows = this->out_x * this->out_y;
 
-                for (int tstep = 0; tstep < time_steps; ++tstep) {
+        auto act_policy = graph.act_policy;
+        auto wgt_policy = graph.wgt_policy;
+        const auto &window_steps = graph.window_steps;
+        auto filter_sets_per_step = graph.filter_sets_per_step;
+        auto total_filter_sets = graph.total_filter_sets;
+        auto time_steps = graph.time_steps;
+        auto max_time_per_step = graph.max_time_per_step;
+        auto last_act_blk = graph.last_act_blk;
+        auto blks_per_window = graph.blks_per_window;
+
+        // Loop indices of the node: window step, filter step and time step
+        auto tstep = (int)(graph.next_node % time_steps);
+        auto fstep = (int)(graph.next_node / time_steps % graph.filter_steps);
+        auto wstep = (int)(graph.next_node / time_steps / graph.filter_steps);
+
+        auto start_window = window_steps[wstep].front() * this->EF_COLUMNS;
+        auto total_windows = std::min(window_steps[wstep].size() * this->EF_COLUMNS,
+                (uint64_t)(num_windows - start_window));
+        auto end_window = start_window + total_windows;
+
+        auto start_filter_set = fstep * filter_sets_per_step;
+        auto filter_per_set = std::min(filter_sets_per_step, total_filter_sets - start_filter_set);
+        auto end_filter_set = start_filter_set + filter_per_set;
+
+        auto start_filter_subset = fstep * filter_sets_per_step * this->arch->getTiles();
+        auto filter_per_subset = std::min(filter_sets_per_step * this->arch->getTiles(),
+                this->filter_sets - start_filter_subset);
+        auto end_filter_subset = start_filter_subset + filter_per_subset;
+
+        auto start_filter = fstep * filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS;
+        auto total_filters = std::min(filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS,
+                (uint32_t)(num_filters - start_filter));
+
+        node->time_step = tstep;
+        node->max_time = max_time_per_step;
+        node->layer_act_on_chip = this->layer_act_on_chip;
+        node->evict_out = graph.next_evict_out;
+        node->groups = {0};
+
+        // Fil activations
+        node->window_sets = window_steps[wstep];
 
-                    auto node = std::make_shared<typename OutputStationary<T>::NodeOutS>();
+        if (act_policy == ALL || act_policy == INPUTS) {
+            if (wstep == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip) {
+                auto first_address = this->act_address_map(0, 0, 0);
+                auto last_address = this->act_address_map(Ny - 1, Nx - 1, last_act_blk - 1);
+                node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                    node->time_step = tstep;
-                    node->max_time = max_time_per_step;
-                    node->layer_act_on_chip = this->layer_act_on_chip;
-                    node->evict_out = next_evict_out;
-                    node->groups = {0};
+        } else if (act_policy == SET || act_policy == SUBSET) {
+            if (fstep == 0 && tstep == 0 && ((!this->layer_act_on_chip && wstep == 0) || wstep != 0)) {
+                node->read_act_addresses = this->generate_addresses(0, blks_per_window, last_act_blk,
+                        start_window, end_window, 0);
+                node->evict_act = true;
+            }
 
-                    // Fil activations
-                    node->window_sets = window_steps[wstep];
+            node->layer_act_on_chip = wstep == 0 ? this->layer_act_on_chip : false;
 
-                    if (act_policy == ALL || act_policy == INPUTS) {
-                        if (wstep == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip) {
-                            auto first_address = this->act_address_map[0][0][0];
-                            auto last_address = this->act_address_map[Ny - 1][Nx - 1][last_act_blk - 1];
-                            node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        }
+        } else {
+            auto start_act_blk = (uint32_t)ceil(tstep * max_time_per_step * this->EF_LANES /
+                    (double)this->dram->getActValuesPerBlock());
 
-                    } else if (act_policy == SET || act_policy == SUBSET) {
-                        if (fstep == 0 && tstep == 0 && ((!this->layer_act_on_chip && wstep == 0) || wstep != 0)) {
-                            node->read_act_addresses = this->generate_addresses(0, blks_per_window, last_act_blk,
-                                    start_window, end_window, 0);
-                            node->evict_act = true;
-                        }
+            auto end_time = (tstep + 1) * max_time_per_step;
+            if (this->arch->schedule()) end_time += this->scheduler->getLookaheadH();
+            auto end_act_blk = (uint32_t)ceil(end_time * this->EF_LANES /
+                    (double)this->dram->getActValuesPerBlock());
+            end_act_blk = std::min(end_act_blk, blks_per_window);
 
-                        node->layer_act_on_chip = wstep == 0 ? this->layer_act_on_chip : false;
+            node->read_act_addresses = this->generate_addresses(start_act_blk, end_act_blk, last_act_blk,
+                    start_window, end_window, 0);
+            node->evict_act = true;
 
-                    } else {
-                        auto start_act_blk = (uint32_t)ceil(tstep * max_time_per_step * this->EF_LANES /
-                                (double)this->dram->getActValuesPerBlock());
+            if (fstep != 0 || tstep != 0)
+                node->use_prev_buffer = true;
 
-                        auto end_time = (tstep + 1) * max_time_per_step;
-                        if (this->arch->schedule()) end_time += this->scheduler->getLookaheadH();
-                        auto end_act_blk = (uint32_t)ceil(end_time * this->EF_LANES /
-                                (double)this->dram->getActValuesPerBlock());
-                        end_act_blk = std::min(end_act_blk, blks_per_window);
+        }
 
-                        node->read_act_addresses = this->generate_addresses(start_act_blk, end_act_blk, last_act_blk,
-                                start_window, end_window, 0);
-                        node->evict_act = true;
+        // Fil filters
+        node->filter_sets = std::vector<int>(filter_per_subset, 0);
+        std::iota(node->filter_sets.begin(), node->filter_sets.end(), start_filter_subset);
 
-                        if (fstep != 0 || tstep != 0)
-                            node->use_prev_buffer = true;
+        if (wgt_policy == ALL) {
+            if (wstep == 0 && fstep == 0 && tstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[0]);
+                auto last_address = std::get<1>(this->wgt_address_map[total_filter_sets - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                    }
+        } else if (wgt_policy == SET) {
+            if (tstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
+                auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+                node->evict_wgt = true;
+            }
 
-                    // Fil filters
-                    node->filter_sets = std::vector<int>(filter_per_subset, 0);
-                    std::iota(node->filter_sets.begin(), node->filter_sets.end(), start_filter_subset);
+        } else {
+            auto start_time = tstep * max_time_per_step;
+            auto end_time = std::min((tstep + 1) * max_time_per_step, (uint32_t)this->max_buffer_time) - 1;
 
-                    if (wgt_policy == ALL) {
-                        if (wstep == 0 && fstep == 0 && tstep == 0) {
-                            auto first_address = std::get<0>(this->wgt_address_map[0]);
-                            auto last_address = std::get<1>(this->wgt_address_map[total_filter_sets - 1]);
-                            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        }
+            uint64_t first_address = NULL_ADDR, last_address = NULL_ADDR;
+            if (this->arch->schedule()) {
+                for (int tmp = start_time; tmp <= end_time; ++tmp) {
 
-                    } else if (wgt_policy == SET) {
-                        if (tstep == 0) {
-                            auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
-                            auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
-                            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                            node->evict_wgt = true;
+                    for (int subset = start_filter_subset; subset < end_filter_subset; ++subset) {
+                        if (subset > this->filter_sets) continue;
+                        if (this->wgt_address_row(subset, tmp).front() != NULL_ADDR) {
+                            first_address = this->wgt_address_row(subset, tmp).front();
+                            break;
                         }
+                    }
 
-                    } else {
-                        auto start_time = tstep * max_time_per_step;
-                        auto end_time = std::min((tstep + 1) * max_time_per_step, (uint32_t)this->max_buffer_time) - 1;
-
-                        uint64_t first_address = NULL_ADDR, last_address = NULL_ADDR;
-                        if (this->arch->schedule()) {
-                            for (int tmp = start_time; tmp <= end_time; ++tmp) {
-
-                                for (int subset = start_filter_subset; subset < end_filter_subset; ++subset) {
-                                    if (subset > this->filter_sets) continue;
-                                    if (this->wgt_address_buffer[subset][tmp].front() != NULL_ADDR) {
-                                        first_address = this->wgt_address_buffer[subset][tmp].front();
-                                        break;
-                                    }
-                                }
-
-                                if (first_address != NULL_ADDR)
-                                    break;
-                            }
-
-                            for (int tmp = end_time; tmp >= (int)start_time; --tmp) {
-                                for (int subset = end_filter_subset; subset > start_filter_subset; --subset) {
-                                    if (subset > this->filter_sets) continue;
-                                    if (this->wgt_address_buffer[subset - 1][tmp].back() != NULL_ADDR) {
-                                        last_address = this->wgt_address_buffer[subset - 1][tmp].back();
-                                        break;
-                                    }
-                                }
-
-                                if (last_address != NULL_ADDR)
-                                    break;
-
-                            }
+                    if (first_address != NULL_ADDR)
+                        break;
+                }
 
-                        } else {
-                            first_address = this->wgt_address_buffer[start_filter_subset][start_time].front();
-                            last_address = this->wgt_address_buffer[end_filter_subset - 1][end_time].back();
+                for (int tmp = end_time; tmp >= (int)start_time; --tmp) {
+                    for (int subset = end_filter_subset; subset > start_filter_subset; --subset) {
+                        if (subset > this->filter_sets) continue;
+                        if (this->wgt_address_row(subset - 1, tmp).back() != NULL_ADDR) {
+                            last_address = this->wgt_address_row(subset - 1, tmp).back();
+                            break;
                         }
+                    }
 
-                        node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        node->evict_wgt = true;
+                    if (last_address != NULL_ADDR)
+                        break;
 
-                    }
+                }
 
-                    // Fil write addresses
-                    if (!this->next_layer_act_on_chip && tstep == time_steps - 1) {
-                        auto first_address = this->dram->getStartActAddress() + next_out_address;
-                        auto out_blks = ceil(total_filters * total_windows /
-                                (double)this->dram->getBaseValuesPerBlock());
-                        next_out_address += out_blks * this->dram->getWidth();
-                        auto last_address = this->dram->getStartActAddress() + next_out_address - this->dram->getWidth();
-                        node->write_addresses.emplace_back(first_address, last_address);
-                        next_evict_out = true;
-                    } else {
-                        next_evict_out = false;
-                    }
+            } else {
+                first_address = this->wgt_address_row(start_filter_subset, start_time).front();
+                last_address = this->wgt_address_row(end_filter_subset - 1, end_time).back();
+            }
 
-                    this->on_chip_graph.emplace_back(node);
+            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            node->evict_wgt = true;
+
+        }
 
-                } // Time step
-            } // Filter step
-        } // Window step
+        // Fil write addresses
+        if (!this->next_layer_act_on_chip && tstep == time_steps - 1) {
+            auto first_address = this->dram->getStartActAddress() + graph.next_out_address;
+            auto out_blks = ceil(total_filters * total_windows /
+                    (double)this->dram->getBaseValuesPerBlock());
+            graph.next_out_address += out_blks * this->dram->getWidth();
+            auto last_address = this->dram->getStartActAddress() + graph.next_out_address - this->dram->getWidth();
+            node->write_addresses.emplace_back(first_address, last_address);
+            graph.next_evict_out = true;
+        } else {
+            graph.next_evict_out = false;
+        }
 
     }
 
@@ -389,107 +415,132 @@ namespace core {
 
         auto last_act_blk = (uint32_t)ceil(act_channels / (double)this->dram->getActValuesPerBlock());
 
-        bool next_evict_out = false;
-        auto next_out_address = this->next_act_address;
-
-        this->on_chip_graph = std::vector<std::shared_ptr<typename Control<T>::Node>>();
-
-        for (int gstep = 0; gstep < group_steps; ++gstep) {
-
-            auto start_group = gstep * groups_per_step;
-            auto total_groups = std::min(groups_per_step, this->groups - start_group);
-            auto start_act_ch = (uint32_t)ceil(start_group * this->filters_per_group
-                    / (double)this->dram->getActValuesPerBlock());
-
-            auto last_grp_act_blk = (uint32_t)ceil(total_groups * this->filters_per_group
-                    / (double)this->dram->getActValuesPerBlock());
-            last_grp_act_blk = std::min(last_grp_act_blk, last_act_blk - start_act_ch);
-            auto blocks_per_step = Ky * Kx * last_grp_act_blk;
-
-            auto start_filter_set = gstep * groups_per_step * filter_sets_per_group;
-            auto filter_per_set = std::min(groups_per_step * filter_sets_per_group, total_filter_sets - start_filter_set);
-            auto end_filter_set = start_filter_set + filter_per_set;
-
-            auto start_filter = gstep * this->filters_per_group;
-            auto total_filters = std::min(total_groups * this->filters_per_group,
-                    (uint32_t)(num_filters - start_filter));
-
-            for (int wstep = 0; wstep < window_steps.size(); ++wstep) {
+        graph.act_policy = act_policy;
+        graph.wgt_policy = wgt_policy;
+        graph.window_steps = std::move(window_steps);
+        graph.groups_per_step = groups_per_step;
+        graph.filter_sets_per_group = filter_sets_per_group;
+        graph.total_filter_sets = total_filter_sets;
+        graph.last_act_blk = last_act_blk;
+        graph.nodes = group_steps * graph.window_steps.size();
+        graph.next_node = 0;
+        graph.next_evict_out = false;
+        graph.next_out_address = this->next_act_address;
 
-                auto start_window = window_steps[wstep].front() * this->EF_COLUMNS;
-                auto total_windows = std::min(window_steps[wstep].size() * this->EF_COLUMNS,
-                        (uint64_t)(num_windows - start_window));
-                auto end_window = start_window + total_windows;
+    }
 
-                auto node = std::make_shared<typename OutputStationary<T>::NodeOutS>();
+    template <typename T>
+    void WindowFirstOutS<T>::generate_node_grouped_layer(const std::shared_ptr<NodeOutS> &node) {
 
-                node->time_step = 0;
-                node->max_time = this->max_buffer_time;
-                node->layer_act_on_chip = this->layer_act_on_chip;
-                node->evict_out = next_evict_out;
+        const std::vector<size_t> &act_shape = this->act->getShape();
+        const std::vector<size_t> &wgt_shape = this->wgt->getShape();
 
-                // Fil groups
-                node->groups = std::vector<int>(total_groups, 0);
-                std::iota(node->groups.begin(), node->groups.end(), start_group);
+        auto Nx = act_shape[2];
+        auto Ny = act_shape[3];
 
-                // Fil activations
-                node->window_sets = window_steps[wstep];
+        auto num_filters = wgt_shape[0];
+        auto Kx = wgt_shape[2];
+        auto Ky = wgt_shape[3];
 
-                if (act_policy == ALL || act_policy == INPUTS) {
-                    if (gstep == 0 && wstep == 0 && !this->layer_act_on_chip) {
-                        auto first_address = this->act_address_map[0][0][0];
-                        auto last_address = this->act_address_map[Ny - 1][Nx - 1][last_act_blk - 1];
-                        node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                    }
+        auto num_windows = this->out_x * this->out_y;
 
-                } else {
-                    if ((!this->layer_act_on_chip && wstep == 0) || wstep != 0) {
-                        node->read_act_addresses = this->generate_addresses(0, blocks_per_step,
-                                last_grp_act_blk, start_window, end_window, start_act_ch);
-                        node->evict_act = true;
-                    }
+        auto act_policy = graph.act_policy;
+        auto wgt_policy = graph.wgt_policy;
+        const auto &window_steps = graph.window_steps;
+        auto groups_per_step = graph.groups_per_step;
+        auto filter_sets_per_group = graph.filter_sets_per_group;
+        auto total_filter_sets = graph.total_filter_sets;
+        auto last_act_blk = graph.last_act_blk;
+
+        // Loop indices of the node: group step and window step
+        auto wstep = (int)(graph.next_node % window_steps.size());
+        auto gstep = (int)(graph.next_node / window_steps.size());
+
+        auto start_group = gstep * groups_per_step;
+        auto total_groups = std::min(groups_per_step, this->groups - start_group);
+        auto start_act_ch = (uint32_t)ceil(start_group * this->filters_per_group
+                / (double)this->dram->getActValuesPerBlock());
+
+        auto last_grp_act_blk = (uint32_t)ceil(total_groups * this->filters_per_group
+                / (double)this->dram->getActValuesPerBlock());
+        last_grp_act_blk = std::min(last_grp_act_blk, last_act_blk - start_act_ch);
+        auto blocks_per_step = Ky * Kx * last_grp_act_blk;
+
+        auto start_filter_set = gstep * groups_per_step * filter_sets_per_group;
+        auto filter_per_set = std::min(groups_per_step * filter_sets_per_group, total_filter_sets - start_filter_set);
+        auto end_filter_set = start_filter_set + filter_per_set;
+
+        auto start_filter = gstep * this->filters_per_group;
+        auto total_filters = std::min(total_groups * this->filters_per_group,
+                (uint32_t)(num_filters - start_filter));
+
+        auto start_window = window_steps[wstep].front() * this->EF_COLUMNS;
+        auto total_windows = std::min(window_steps[wstep].size() * this->EF_COLUMNS,
+                (uint64_t)(num_windows - start_window));
+        auto end_window = start_window + total_windows;
+
+        node->time_step = 0;
+        node->max_time = this->max_buffer_time;
+        node->layer_act_on_chip = this->layer_act_on_chip;
+        node->evict_out = graph.next_evict_out;
+
+        // Fil groups
+        node->groups = std::vector<int>(total_groups, 0);
+        std::iota(node->groups.begin(), node->groups.end(), start_group);
+
+        // Fil activations
+        node->window_sets = window_steps[wstep];
 
-                    node->layer_act_on_chip = gstep == 0 && wstep == 0 ? this->layer_act_on_chip : false;
+        if (act_policy == ALL || act_policy == INPUTS) {
+            if (gstep == 0 && wstep == 0 && !this->layer_act_on_chip) {
+                auto first_address = this->act_address_map(0, 0, 0);
+                auto last_address = this->act_address_map(Ny - 1, Nx - 1, last_act_blk - 1);
+                node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                }
+        } else {
+            if ((!this->layer_act_on_chip && wstep == 0) || wstep != 0) {
+                node->read_act_addresses = this->generate_addresses(0, blocks_per_step,
+                        last_grp_act_blk, start_window, end_window, start_act_ch);
+                node->evict_act = true;
+            }
 
-                // Fil filters
-                node->filter_sets = std::vector<int>(this->filter_sets, 0);
-                std::iota(node->filter_sets.begin(), node->filter_sets.end(), 0);
+            node->layer_act_on_chip = gstep == 0 && wstep == 0 ? this->layer_act_on_chip : false;
 
-                if (wgt_policy == ALL) {
-                    if (gstep == 0 && wstep == 0) {
-                        auto first_address = std::get<0>(this->wgt_address_map[0]);
-                        auto last_address = std::get<1>(this->wgt_address_map[this->filter_sets * this->groups - 1]);
-                        node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                    }
+        }
 
-                } else {
-                    if (wstep == 0) {
-                        auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
-                        auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
-                        node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        node->evict_wgt = true;
-                    }
+        // Fil filters
+        node->filter_sets = std::vector<int>(this->filter_sets, 0);
+        std::iota(node->filter_sets.begin(), node->filter_sets.end(), 0);
 
-                }
+        if (wgt_policy == ALL) {
+            if (gstep == 0 && wstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[0]);
+                auto last_address = std::get<1>(this->wgt_address_map[this->filter_sets * this->groups - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                // Fil write addresses
-                if (!this->next_layer_act_on_chip) {
-                    auto first_address = this->dram->getStartActAddress() + next_out_address;
-                    auto out_blks = ceil(total_filters * total_windows / (double)this->dram->getBaseValuesPerBlock());
-                    next_out_address += out_blks * this->dram->getWidth();
-                    auto last_address = this->dram->getStartActAddress() + next_out_address - this->dram->getWidth();
-                    node->write_addresses.emplace_back(first_address, last_address);
-                    next_evict_out = true;
-                } else {
-                    next_evict_out = false;
-                }
+        } else {
+            if (wstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
+                auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+                node->evict_wgt = true;
+            }
 
-                this->on_chip_graph.emplace_back(node);
+        }
 
-            } // Window step
-        } // Groups
+        // Fil write addresses
+        if (!this->next_layer_act_on_chip) {
+            auto first_address = this->dram->getStartActAddress() + graph.next_out_address;
+            auto out_blks = ceil(total_filters * total_windows / (double)this->dram->getBaseValuesPerBlock());
+            graph.next_out_address += out_blks * this->dram->getWidth();
+            auto last_address = this->dram->getStartActAddress() + graph.next_out_address - this->dram->getWidth();
+            node->write_addresses.emplace_back(first_address, last_address);
+            graph.next_evict_out = true;
+        } else {
+            graph.next_evict_out = false;
+        }
 
     }
 
@@ -581,164 +632,183 @@ namespace core {
         auto last_act_blk = (uint32_t)ceil(act_channels / (double)this->dram->getActValuesPerBlock());
         auto blocks_per_time = (uint32_t)ceil(last_act_blk / (double)this->max_buffer_time);
 
-        bool next_evict_out = false;
+        graph.act_policy = act_policy;
+        graph.wgt_policy = wgt_policy;
+        graph.filter_steps = filter_steps;
+        graph.filter_sets_per_step = filter_sets_per_step;
+        graph.total_filter_sets = total_filter_sets;
+        graph.time_steps = time_steps;
+        graph.max_time_per_step = max_time_per_step;
+        graph.last_act_blk = last_act_blk;
+        graph.nodes = recurrences * filter_steps * time_steps;
+        graph.next_node = 0;
+        graph.next_evict_out = false;
+        graph.next_out_address = this->next_act_address;
 
-        this->on_chip_graph = std::vector<std::shared_ptr<typename Control<T>::Node>>();
+    }
 
-        for (int r = 0; r < recurrences; ++r) {
+    template <typename T>
+    void WindowFirstOutS<T>::generate_node_linear_layer(const std::shared_ptr<NodeOutS> &node) {
 
-            auto next_out_address = this->next_act_address;
+        const std::vector<size_t> &wgt_shape = this->wgt->getShape();
 
-            for (int fstep = 0; fstep < filter_steps; ++fstep) {
+        auto num_filters = wgt_shape[0];
 
-                auto start_filter_set = fstep * filter_sets_per_step;
-                auto filter_per_set = std::min(filter_sets_per_step, total_filter_sets - start_filter_set);
-                auto end_filter_set = start_filter_set + filter_per_set;
+        auto act_policy = graph.act_policy;
+        auto wgt_policy = graph.wgt_policy;
+        auto filter_sets_per_step = graph.filter_sets_per_step;
+        auto total_filter_sets = graph.total_filter_sets;
+        auto time_steps = graph.time_steps;
+        auto max_time_per_step = graph.max_time_per_step;
+        auto last_act_blk = graph.last_act_blk;
+
+        // Loop indices of the node: recurrence, filter step and time step
+        auto tstep = (int)(graph.next_node % time_steps);
+        auto fstep = (int)(graph.next_node / time_steps % graph.filter_steps);
+        auto r = (int)(graph.next_node / time_steps / graph.filter_steps);
+
+        // The outputs of every recurrence overwrite the previous ones
+        if (fstep == 0 && tstep == 0)
+            graph.next_out_address = this->next_act_address;
+
+        auto start_filter_set = fstep * filter_sets_per_step;
+        auto filter_per_set = std::min(filter_sets_per_step, total_filter_sets - start_filter_set);
+        auto end_filter_set = start_filter_set + filter_per_set;
+
+        auto start_filter_subset = fstep * filter_sets_per_step * this->arch->getTiles();
+        auto filter_per_subset = std::min(filter_sets_per_step * this->arch->getTiles(),
+                this->filter_sets - start_filter_subset);
+        auto end_filter_subset = start_filter_subset + filter_per_subset;
+
+        auto start_filter = fstep * filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS;
+        auto total_filters = std::min(filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS,
+                (uint32_t)(num_filters - start_filter));
+
+        node->time_step = tstep;
+        node->max_time = max_time_per_step;
+        node->layer_act_on_chip = this->layer_act_on_chip;
+        node->evict_out = graph.next_evict_out;
+        node->recurrence = r;
+        node->window_sets = {0};
+
+        // Fil activations
+        if (act_policy == ALL) {
+            if (r == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip) {
+                auto first_address = this->act_address_map(0, 0, 0);
+                auto last_address = this->act_address_map(0, 0, last_act_blk - 1);
+                node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                auto start_filter_subset = fstep * filter_sets_per_step * this->arch->getTiles();
-                auto filter_per_subset = std::min(filter_sets_per_step * this->arch->getTiles(),
-                        this->filter_sets - start_filter_subset);
-                auto end_filter_subset = start_filter_subset + filter_per_subset;
+            if (fstep != 0 || tstep != 0)
+                node->use_prev_buffer = true;
 
-                auto start_filter = fstep * filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS;
-                auto total_filters = std::min(filter_sets_per_step * this->arch->getTiles() * this->EF_ROWS,
-                        (uint32_t)(num_filters - start_filter));
+        } else if (act_policy == INPUTS) {
+            if (fstep == 0 && tstep == 0 && ((!this->layer_act_on_chip && r == 0) || r != 0)) {
+                auto first_address = this->act_address_map(0, 0, 0);
+                auto last_address = this->act_address_map(0, 0, last_act_blk - 1);
+                node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
+                node->evict_act = true;
+            }
 
-                for (int tstep = 0; tstep < time_steps; ++tstep) {
+            node->layer_act_on_chip = r == 0 ? this->layer_act_on_chip : false;
 
-                    auto node = std::make_shared<typename OutputStationary<T>::NodeOutS>();
+            if (fstep != 0)
+                node->use_prev_buffer = true;
 
-                    node->time_step = tstep;
-                    node->max_time = max_time_per_step;
-                    node->layer_act_on_chip = this->layer_act_on_chip;
-                    node->evict_out = next_evict_out;
-                    node->recurrence = r;
-                    node->window_sets = {0};
+        } else {
+            auto start_act_blk = (uint32_t)ceil(tstep * max_time_per_step * this->EF_LANES /
+                    (double)this->dram->getActValuesPerBlock());
 
-                    // Fil activations
-                    if (act_policy == ALL) {
-                        if (r == 0 && fstep == 0 && tstep == 0 && !this->layer_act_on_chip) {
-                            auto first_address = this->act_address_map[0][0][0];
-                            auto last_address = this->act_address_map[0][0][last_act_blk - 1];
-                            node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        }
+            auto end_time = (tstep + 1) * max_time_per_step;
+            if (this->arch->schedule()) end_time += this->scheduler->getLookaheadH();
+            auto end_act_blk = (uint32_t)ceil(end_time * this->EF_LANES /
+                    (double)this->dram->getActValuesPerBlock());
+            end_act_blk = std::min(end_act_blk, last_act_blk);
 
-                        if (fstep != 0 || tstep != 0)
-                            node->use_prev_buffer = true;
+            auto first_address = this->act_address_map(0, 0, start_act_blk);
+            auto last_address = this->act_address_map(0, 0, end_act_blk - 1);
+            node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            node->evict_act = true;
 
-                    } else if (act_policy == INPUTS) {
-                        if (fstep == 0 && tstep == 0 && ((!this->layer_act_on_chip && r == 0) || r != 0)) {
-                            auto first_address = this->act_address_map[0][0][0];
-                            auto last_address = this->act_address_map[0][0][last_act_blk - 1];
-                            node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                            node->evict_act = true;
-                        }
+            if (fstep != 0 || tstep != 0)
+                node->use_prev_buffer = true;
 
-                        node->layer_act_on_chip = r == 0 ? this->layer_act_on_chip : false;
+        }
 
-                        if (fstep != 0)
-                            node->use_prev_buffer = true;
+        // Fil filters
+        node->filter_sets = std::vector<int>(filter_per_subset, 0);
+        std::iota(node->filter_sets.begin(), node->filter_sets.end(), start_filter_subset);
 
-                    } else {
-                        auto start_act_blk = (uint32_t)ceil(tstep * max_time_per_step * this->EF_LANES /
-                                (double)this->dram->getActValuesPerBlock());
+        if (wgt_policy == ALL) {
+            if (r == 0 && fstep == 0 && tstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[0]);
+                auto last_address = std::get<1>(this->wgt_address_map[total_filter_sets - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            }
 
-                        auto end_time = (tstep + 1) * max_time_per_step;
-                        if (this->arch->schedule()) end_time += this->scheduler->getLookaheadH();
-                        auto end_act_blk = (uint32_t)ceil(end_time * this->EF_LANES /
-                                (double)this->dram->getActValuesPerBlock());
-                        end_act_blk = std::min(end_act_blk, last_act_blk);
+        } else if (wgt_policy == SET) {
+            if (tstep == 0) {
+                auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
+                auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
+                node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+                node->evict_wgt = true;
+            }
 
-                        auto first_address = this->act_address_map[0][0][start_act_blk];
-                        auto last_address = this->act_address_map[0][0][end_act_blk - 1];
-                        node->read_act_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        node->evict_act = true;
+        } else {
+            auto start_time = tstep * max_time_per_step;
+            auto end_time = std::min((tstep + 1) * max_time_per_step, (uint32_t)this->max_buffer_time) - 1;
 
-                        if (fstep != 0 || tstep != 0)
-                            node->use_prev_buffer = true;
+            uint64_t first_address = NULL_ADDR, last_address = NULL_ADDR;
+            if (this->arch->schedule()) {
+                for (int tmp = start_time; tmp <= end_time; ++tmp) {
 
+                    for (int subset = start_filter_subset; subset < end_filter_subset; ++subset) {
+                        if (subset > this->filter_sets) continue;
+                        if (this->wgt_address_row(subset, tmp).front() != NULL_ADDR) {
+                            first_address = this->wgt_address_row(subset, tmp).front();
+                            break;
+                        }
                     }
 
-                    // Fil filters
-                    node->filter_sets = std::vector<int>(filter_per_subset, 0);
-                    std::iota(node->filter_sets.begin(), node->filter_sets.end(), start_filter_subset);
-
-                    if (wgt_policy == ALL) {
-                        if (r == 0 && fstep == 0 && tstep == 0) {
-                            auto first_address = std::get<0>(this->wgt_address_map[0]);
-                            auto last_address = std::get<1>(this->wgt_address_map[total_filter_sets - 1]);
-                            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        }
+                    if (first_address != NULL_ADDR)
+                        break;
+                }
 
-                    } else if (wgt_policy == SET) {
-                        if (tstep == 0) {
-                            auto first_address = std::get<0>(this->wgt_address_map[start_filter_set]);
-                            auto last_address = std::get<1>(this->wgt_address_map[end_filter_set - 1]);
-                            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                            node->evict_wgt = true;
+                for (int tmp = end_time; tmp >= start_time ; --tmp) {
+                    for (int subset = end_filter_subset; subset > start_filter_subset; --subset) {
+                        if (subset > this->filter_sets) continue;
+                        if (this->wgt_address_row(subset - 1, tmp).back() != NULL_ADDR) {
+                            last_address = this->wgt_address_row(subset - 1, tmp).back();
+                            break;
                         }
+                    }
 
-                    } else {
-                        auto start_time = tstep * max_time_per_step;
-                        auto end_time = std::min((tstep + 1) * max_time_per_step, (uint32_t)this->max_buffer_time) - 1;
-
-                        uint64_t first_address = NULL_ADDR, last_address = NULL_ADDR;
-                        if (this->arch->schedule()) {
-                            for (int tmp = start_time; tmp <= end_time; ++tmp) {
-
-                                for (int subset = start_filter_subset; subset < end_filter_subset; ++subset) {
-                                    if (subset > this->filter_sets) continue;
-                                    if (this->wgt_address_buffer[subset][tmp].front() != NULL_ADDR) {
-                                        first_address = this->wgt_address_buffer[subset][tmp].front();
-                                        break;
-                                    }
-                                }
-
-                                if (first_address != NULL_ADDR)
-                                    break;
-                            }
-
-                            for (int tmp = end_time; tmp >= start_time ; --tmp) {
-                                for (int subset = end_filter_subset; subset > start_filter_subset; --subset) {
-                                    if (subset > this->filter_sets) continue;
-                                    if (this->wgt_address_buffer[subset - 1][tmp].back() != NULL_ADDR) {
-                                        last_address = this->wgt_address_buffer[subset - 1][tmp].back();
-                                        break;
-                                    }
-                                }
-
-                                if (last_address != NULL_ADDR)
-                                    break;
-
-                            }
-
-                        } else {
-                            first_address = this->wgt_address_buffer[start_filter_subset][start_time].front();
-                            last_address = this->wgt_address_buffer[end_filter_subset - 1][end_time].back();
-                        }
+                    if (last_address != NULL_ADDR)
+                        break;
 
-                        node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
-                        node->evict_wgt = true;
+                }
 
-                    }
+            } else {
+                first_address = this->wgt_address_row(start_filter_subset, start_time).front();
+                last_address = this->wgt_address_row(end_filter_subset - 1, end_time).back();
+            }
 
-                    // Fil write addresses
-                    if (!this->next_layer_act_on_chip && tstep == time_steps - 1) {
-                        auto first_address = this->dram->getStartActAddress() + next_out_address;
-                        auto out_blks = ceil(total_filters / (double)this->dram->getBaseValuesPerBlock());
-                        next_out_address += out_blks * this->dram->getWidth();
-                        auto last_address = this->dram->getStartActAddress() + next_out_address - this->dram->getWidth();
-                        node->write_addresses.emplace_back(first_address, last_address);
-                        next_evict_out = true;
-                    } else {
-                        next_evict_out = false;
-                    }
+            node->read_wgt_addresses.emplace_back(std::make_tuple(first_address, last_address));
+            node->evict_wgt = true;
 
-                    this->on_chip_graph.emplace_back(node);
+        }
 
-                } // Time step
-            } // Filter step
-        } // Recurrence
+        // Fil write addresses
+        if (!this->next_layer_act_on_chip && tstep == time_steps - 1) {
+            auto first_address = this->dram->getStartActAddress() + graph.next_out_address;
+            auto out_blks = ceil(total_filters / (double)this->dram->getBaseValuesPerBlock());
+            graph.next_out_address += out_blks * this->dram->getWidth();
+            auto last_address = this->dram->getStartActAddress() + graph.next_out_address - this->dram->getWidth();
+            node->write_addresses.emplace_back(first_address, last_address);
+            graph.next_evict_out = true;
+        } else {
+            graph.next_evict_out = false;
+        }
 
     }
 
@@ -747,6 +817,22 @@ namespace core {
         if (this->linear) generate_execution_graph_linear_layer();
         else if (this->groups > 1) generate_execution_graph_grouped_layer();
         else generate_execution_graph_conv_layer();
+
+        generate_next_node();
+    }
+
+    template <typename T>
+    bool WindowFirstOutS<T>::generate_next_node() {
+        if (graph.next_node == graph.nodes)
+            return false;
+
+        auto node = this->template reuse_node<NodeOutS>();
+        if (this->linear) generate_node_linear_layer(node);
+        else if (this->groups > 1) generate_node_grouped_layer(node);
+        else generate_node_conv_layer(node);
+
+        graph.next_node++;
+        return true;
     }
 
     template <typename T>
@@ -765,12 +851,44 @@ namespace core {
 
     }
 
+    template <typename T>
+    typename Control<T>::LayerState WindowFirstOutS<T>::next_layer_state(
+            const typename Control<T>::LayerState &state, const std::vector<size_t> &act_shape,
+            const std::vector<size_t> &wgt_shape, uint32_t act_prec, uint32_t wgt_prec, bool _linear, bool __3dim,
+            int _stride) const {
+
+        auto next_state = OutputStationary<T>::next_layer_state(state, act_shape, wgt_shape, act_prec, wgt_prec,
+                _linear, __3dim, _stride);
+        next_state.next_out_address = next_state.next_act_address;
+
+        // The activations stay on-chip when the execution graph takes the ALL policy for them
+        auto num_filters = wgt_shape[0];
+        uint64_t input_values, output_values;
+        if (_linear) {
+            input_values = __3dim ? act_shape[2] : act_shape[1];
+            output_values = num_filters;
+        } else {
+            auto Nx = act_shape[2];
+            auto Ny = act_shape[3];
+            auto out_x = (int)((Nx - wgt_shape[2]) / _stride + 1);
+            auto out_y = (int)((Ny - wgt_shape[3]) / _stride + 1);
+            input_values = act_shape[1] * Nx * Ny;
+            output_values = num_filters * out_x * out_y;
+        }
+
+        auto all_input_size = (uint32_t)ceil(input_values * this->dram_data_size(act_prec) / 8.);
+        auto all_output_size = (uint32_t)ceil(output_values * this->dram->getBaseDataSize() / 8.);
+        next_state.next_layer_act_on_chip = all_input_size + all_output_size <= this->gbuffer->getActSize();
+
+        return next_state;
+    }
+
     template <typename T>
     bool WindowFirstOutS<T>::still_on_chip_data_conv_layer(TilesData<T> &_tiles_data) {
 
         // Select values from current node
         const auto &current_node = std::static_pointer_cast<typename OutputStationary<T>::NodeOutS>
-                (this->on_chip_graph.front());
+                (this->current_node());
         const auto &groups = current_node->groups;
         const auto &window_sets = current_node->window_sets;
         const auto &filter_tile_sets = current_node->filter_sets;
@@ -797,7 +915,7 @@ namespace core {
 
                         auto x_window = window % this->out_x;
                         auto y_window = window / this->out_y;
-                        this->windows.emplace_back(std::make_tuple(x_window, y_window));
+                        this->windows->emplace_back(std::make_tuple(x_window, y_window));
                     }
 
                     if (!use_prev_buffer)
@@ -814,7 +932,7 @@ namespace core {
 
                         if (time_step == 0) this->tiles_done = false;
 
-                        this->filters = std::vector<std::vector<int>>(this->arch->getTiles(), std::vector<int>());
+                        this->filters = std::make_shared<std::vector<std::vector<int>>>(this->arch->getTiles());
 
                         // Select filter for each tile
                         for (int t = 0; t < this->arch->getTiles(); ++t) {
@@ -826,7 +944,7 @@ namespace core {
                                 auto filter = filter_idx + r;
                                 if (filter >= ((group_idx + 1)) * this->filters_per_group || filter >= num_filters)
                                     continue;
-                                this->filters[t].push_back(filter);
+                                (*this->filters)[t].push_back(filter);
                             }
 
                         }
@@ -840,7 +958,7 @@ namespace core {
 
                         tiles_data[t].valid = false;
 
-                        if (this->filters[t].empty()) break;
+                        if ((*this->filters)[t].empty()) break;
 
                         while (this->time[t] < max_time && !this->tiles_done) {
                             auto set_time = time_step * max_time + this->time[t];
@@ -852,7 +970,7 @@ namespace core {
 
                                 // Skip lines of zeroes
                                 bool zero_line = this->scheduler->check_zero_line(this->weight_buffer
-                                        [group_idx * this->filter_sets + filter_set + t][set_time]);
+                                        [group_idx * this->filter_sets + filter_set + t], set_time);
                                 if (this->skip[t] < this->scheduler->getLookaheadH() && zero_line) {
                                     this->skip[t]++;
                                     this->time[t]++;
@@ -864,39 +982,33 @@ namespace core {
 
                             auto num_act_rows = 1;
                             if (this->arch->schedule()) num_act_rows += this->scheduler->getLookaheadH();
-                            tiles_data[t].act_row = BufferSet<T>(this->window_buffer.begin() + set_time,
-                                    std::min(this->window_buffer.begin() + set_time +
-                                    num_act_rows, this->window_buffer.end()));
+                            tiles_data[t].act_row = BufferSlice<T>(this->window_buffer, set_time,
+                                    set_time + num_act_rows);
                             if (first) {
-                                tiles_data[t].act_addresses =
-                                        AddressBufferSet(
-                                        std::min(this->window_address_buffer.begin() + this->requested,
-                                        this->window_address_buffer.end()),
-                                        std::min(this->window_address_buffer.begin() + set_time + num_act_rows,
-                                        this->window_address_buffer.end()));
-                                tiles_data[t].act_banks =
-                                        BankBufferSet(
-                                        std::min(this->window_bank_buffer.begin() + this->requested,
-                                        this->window_bank_buffer.end()),
-                                        std::min(this->window_bank_buffer.begin() + set_time + num_act_rows,
-                                        this->window_bank_buffer.end()));
+                                // Request the window rows up to the last one of this tile. The first tile with
+                                // work can be behind the tile that made the last request, its rows are already
+                                // requested and the request is empty
+                                auto last_row = std::min((uint64_t)set_time + num_act_rows,
+                                        (uint64_t)this->window_address_buffer->size());
+                                auto first_row = std::min((uint64_t)this->requested, last_row);
+                                tiles_data[t].act_addresses = Span<AddressBufferRow>(this->window_address_buffer,
+                                        first_row, last_row);
+                                tiles_data[t].act_banks = Span<BankBufferRow>(this->window_bank_buffer,
+                                        first_row, last_row);
 
                                 this->requested = set_time + num_act_rows;
                                 first = false;
-                            } else {
-                                tiles_data[t].act_addresses.clear();
-                                tiles_data[t].act_banks.clear();
                             }
 
-                            tiles_data[t].wgt_row =
-                                    this->weight_buffer[group_idx * this->filter_sets + filter_set + t][set_time];
-                            tiles_data[t].wgt_addresses =
-                                    this->wgt_address_buffer[group_idx * this->filter_sets + filter_set + t][set_time];
-                            tiles_data[t].wgt_banks =
-                                    this->wgt_bank_buffer[group_idx * this->filter_sets + filter_set + t][set_time];
+                            auto wgt_set = group_idx * this->filter_sets + filter_set + t;
+                            tiles_data[t].wgt_row = this->weight_buffer[wgt_set].row(set_time);
+                            tiles_data[t].wgt_addresses = this->wgt_address_row(wgt_set, set_time);
+                            tiles_data[t].wgt_banks = this->wgt_bank_row(wgt_set);
 
-                            tiles_data[t].windows = this->windows;
-                            tiles_data[t].filters = this->filters[t];
+                            tiles_data[t].windows = Span<WindowCoord>(this->windows, this->windows->data(),
+                                    this->windows->size());
+                            tiles_data[t].filters = Span<int>(this->filters, (*this->filters)[t].data(),
+                                    (*this->filters)[t].size());
                             tiles_data[t].time = set_time;
                             tiles_data[t].lanes = this->EF_LANES;
                             tiles_data[t].valid = true;
@@ -925,7 +1037,7 @@ namespace core {
                             auto out_bank_idx = 0;
                             for (int t = 0; t < this->arch->getTiles(); ++t) {
                                 if (!this->write[t]) continue;
-                                auto outputs = (uint32_t)ceil(this->windows.size() * this->filters[t].size() /
+                                auto outputs = (uint32_t)ceil(this->windows->size() * (*this->filters)[t].size() /
                                         (double)this->gbuffer->getActAddrsPerAccess());
                                 tiles_data[t].out_addresses = AddressBufferRow(outputs, 0);
                                 tiles_data[t].out_banks = BankBufferRow(outputs, 0);
@@ -949,13 +1061,13 @@ namespace core {
                     this->write = std::vector<bool>(this->arch->getTiles(), false);
                     this->time = std::vector<int>(this->arch->getTiles(), 0);
                     this->filter_buffer_filled = false;
-                    this->filters.clear();
+                    this->filters.reset();
                     this->filter_set_it += this->arch->getTiles();
                 } // Filter set
 
                 this->filter_set_it = 0;
                 this->window_buffer_filled = false;
-                this->windows.clear();
+                this->windows = std::make_shared<std::vector<WindowCoord>>();
                 this->window_set_it++;
             } // Window set
 
@@ -973,7 +1085,7 @@ namespace core {
 
         // Select values from current node
         const auto &current_node = std::static_pointer_cast<typename OutputStationary<T>::NodeOutS>
-                (this->on_chip_graph.front());
+                (this->current_node());
         const auto &filter_tile_sets = current_node->filter_sets;
         const auto &time_step = current_node->time_step;
         const auto &max_time = current_node->max_time;
@@ -982,7 +1094,7 @@ namespace core {
 
         // Fill window buffer
         if (!use_prev_buffer && !this->window_buffer_filled) {
-            this->windows = {{0, 0}};
+            this->windows = std::make_shared<std::vector<WindowCoord>>(1, WindowCoord(0, 0));
             this->fill_window_buffer(0);
             this->window_buffer_filled = true;
         }
@@ -996,7 +1108,7 @@ namespace core {
 
                 if (time_step == 0) this->tiles_done = false;
 
-                this->filters = std::vector<std::vector<int>>(this->arch->getTiles(), std::vector<int>());
+                this->filters = std::make_shared<std::vector<std::vector<int>>>(this->arch->getTiles());
 
                 // Select filter for each tile
                 for (int t = 0; t < this->arch->getTiles(); ++t) {
@@ -1008,7 +1120,7 @@ namespace core {
                         auto filter = filter_idx + r;
                         if (filter >= num_filters)
                             continue;
-                        this->filters[t].push_back(filter);
+                        (*this->filters)[t].push_back(filter);
                     }
 
                 }
@@ -1022,7 +1134,7 @@ namespace core {
 
                 tiles_data[t].valid = false;
 
-                if (this->filters[t].empty()) break;
+                if ((*this->filters)[t].empty()) break;
 
                 while (this->time[t] < max_time && !this->tiles_done) {
                     auto set_time = time_step * max_time + this->time[t];
@@ -1033,7 +1145,7 @@ namespace core {
                     if (this->arch->schedule()) {
 
                         // Skip lines of zeroes
-                        bool zero_line = this->scheduler->check_zero_line(this->weight_buffer[filter_set + t][set_time]);
+                        bool zero_line = this->scheduler->check_zero_line(this->weight_buffer[filter_set + t], set_time);
                         if (this->skip[t] < this->scheduler->getLookaheadH() && zero_line) {
                             this->skip[t]++;
                             this->time[t]++;
@@ -1045,36 +1157,31 @@ namespace core {
 
                     auto num_act_rows = 1;
                     if (this->arch->schedule()) num_act_rows += this->scheduler->getLookaheadH();
-                    tiles_data[t].act_row = BufferSet<T>(this->window_buffer.begin() + set_time,
-                            std::min(this->window_buffer.begin() + set_time +
-                            num_act_rows, this->window_buffer.end()));
+                    tiles_data[t].act_row = BufferSlice<T>(this->window_buffer, set_time, set_time + num_act_rows);
                     if (first) {
-                        tiles_data[t].act_addresses =
-                                AddressBufferSet(
-                                std::min(this->window_address_buffer.begin() + this->requested,
-                                this->window_address_buffer.end()),
-                                std::min(this->window_address_buffer.begin() + set_time + num_act_rows,
-                                this->window_address_buffer.end()));
-                        tiles_data[t].act_banks =
-                                BankBufferSet(
-                                std::min(this->window_bank_buffer.begin() + this->requested,
-                                this->window_bank_buffer.end()),
-                                std::min(this->window_bank_buffer.begin() + set_time + num_act_rows,
-                                this->window_bank_buffer.end()));
+                        // Request the window rows up to the last one of this tile. The first tile with work can be
+                        // behind the tile that made the last request, its rows are already requested and the
+                        // request is empty
+                        auto last_row = std::min((uint64_t)set_time + num_act_rows,
+                                (uint64_t)this->window_address_buffer->size());
+                        auto first_row = std::min((uint64_t)this->requested, last_row);
+                        tiles_data[t].act_addresses = Span<AddressBufferRow>(this->window_address_buffer,
+                                first_row, last_row);
+                        tiles_data[t].act_banks = Span<BankBufferRow>(this->window_bank_buffer, first_row,
+                                last_row);
 
                         this->requested = set_time + num_act_rows;
                         first = false;
-                    } else {
-                        tiles_data[t].act_addresses.clear();
-                        tiles_data[t].act_banks.clear();
                     }
 
-                    tiles_data[t].wgt_row = this->weight_buffer[filter_set + t][set_time];
-                    tiles_data[t].wgt_addresses = this->wgt_address_buffer[filter_set + t][set_time];
-                    tiles_data[t].wgt_banks = this->wgt_bank_buffer[filter_set + t][set_time];
+                    tiles_data[t].wgt_row = this->weight_buffer[filter_set + t].row(set_time);
+                    tiles_data[t].wgt_addresses = this->wgt_address_row(filter_set + t, set_time);
+                    tiles_data[t].wgt_banks = this->wgt_bank_row(filter_set + t);
 
-                    tiles_data[t].windows = std::vector<WindowCoord>(this->EF_COLUMNS, {0, 0});
-                    tiles_data[t].filters = this->filters[t];
+                    tiles_data[t].windows = Span<WindowCoord>(this->linear_windows, this->linear_windows->data(),
+                            this->linear_windows->size());
+                    tiles_data[t].filters = Span<int>(this->filters, (*this->filters)[t].data(),
+                            (*this->filters)[t].size());
                     tiles_data[t].time = set_time;
                     tiles_data[t].lanes = this->EF_LANES;
                     tiles_data[t].valid = true;
@@ -1103,7 +1210,7 @@ namespace core {
                     auto out_bank_idx = 0;
                     for (int t = 0; t < this->arch->getTiles(); ++t) {
                         if (!this->write[t]) continue;
-                        auto outputs = (uint32_t)ceil(this->filters[t].size() /
+                        auto outputs = (uint32_t)ceil((*this->filters)[t].size() /
                                 (double)this->gbuffer->getActAddrsPerAccess());
 
                         tiles_data[t].out_addresses = AddressBufferRow(outputs, 0);
@@ -1127,7 +1234,7 @@ namespace core {
             this->write = std::vector<bool>(this->arch->getTiles(), false);
             this->time = std::vector<int>(this->arch->getTiles(), 0);
             this->filter_buffer_filled = false;
-            this->filters.clear();
+            this->filters.reset();
             this->filter_set_it += this->arch->getTiles();
         } // Filter set
 
@@ -36,12 +36,20 @@ THE SOFTWARE.
 #include <core/BitTactical.h>
 #include <core/WindowFirstOutS.h>
 
+#include <functional>
+#include <map>
+#include <sys/wait.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 template <typename T>
-base::Network<T> read(const sys::Batch::Simulate &simulate, bool QUIET) {
+base::Network<T> read(const sys::Batch::Simulate &simulate, uint32_t N_THREADS, bool QUIET) {
 
     // Read the network
     base::Network<T> network;
-    base::NetReader<T> reader = base::NetReader<T>(simulate.network, simulate.batch, 0, QUIET);
+    base::NetReader<T> reader = base::NetReader<T>(simulate.network, simulate.batch, 0, N_THREADS, QUIET);
     if (simulate.model == "Caffe") {
         network = reader.read_network_caffe();
         network.setQuantised(simulate.quantised);
@@ -66,9 +74,348 @@ base::Network<T> read(const sys::Batch::Simulate &simulate, bool QUIET) {
 
 }
 
+template <typename T, typename A>
+std::vector<std::shared_ptr<core::Control<T>>> read_controls(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::string &network_name,
+        const std::shared_ptr<core::Architecture<T>> &arch, uint64_t copies, uint32_t N_THREADS) {
+
+    // One independent memory hierarchy and architecture per simulation thread
+    std::vector<std::shared_ptr<core::Control<T>>> controls;
+    for (uint64_t c = 0; c < copies; ++c) {
+
+        auto tracked_data = std::make_shared<core::AddressTable>(experiment.dram_start_act_address,
+                experiment.dram_start_wgt_address, experiment.dram_width);
+        auto act_addresses = std::make_shared<core::AddressRange>();
+        auto out_addresses = std::make_shared<core::AddressRange>();
+        auto wgt_addresses = std::make_shared<core::AddressRange>();
+
+        auto dram = std::make_shared<core::DRAM<T>>(tracked_data, act_addresses, out_addresses, wgt_addresses,
+                experiment.dram_width, experiment.dram_size, simulate.data_width, experiment.cpu_clock_freq,
+                experiment.dram_start_act_address, experiment.dram_start_wgt_address, experiment.dram_conf,
+                "system.ini", network_name);
+
+        auto gbuffer = std::make_shared<core::GlobalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+                wgt_addresses, experiment.gbuffer_act_levels, experiment.gbuffer_wgt_levels,
+                experiment.gbuffer_act_size, experiment.gbuffer_wgt_size, experiment.gbuffer_act_banks,
+                experiment.gbuffer_wgt_banks, experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width,
+                experiment.dram_width, experiment.gbuffer_act_read_delay, experiment.gbuffer_act_write_delay,
+                experiment.gbuffer_wgt_read_delay, experiment.gbuffer_act_eviction_policy,
+                experiment.gbuffer_wgt_eviction_policy);
+
+        auto abuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+                wgt_addresses, experiment.abuffer_rows, experiment.abuffer_read_delay, core::NULL_DELAY);
+
+        auto pbuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+                wgt_addresses, experiment.pbuffer_rows, experiment.pbuffer_read_delay, core::NULL_DELAY);
+
+        auto wbuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+                wgt_addresses, experiment.wbuffer_rows, experiment.wbuffer_read_delay, core::NULL_DELAY);
+
+        auto obuffer = std::make_shared<core::LocalBuffer<T>>(tracked_data, act_addresses, out_addresses,
+                wgt_addresses, experiment.obuffer_rows, core::NULL_DELAY, experiment.obuffer_write_delay);
+
+        auto composer = std::make_shared<core::Composer<T>>(experiment.composer_inputs, experiment.composer_delay);
+
+        auto ppu = std::make_shared<core::PPU<T>>(experiment.ppu_inputs, experiment.ppu_delay);
+
+        auto scheduler = std::make_shared<core::BitTactical<T>>(experiment.lookahead_h, experiment.lookaside_d,
+                experiment.search_shape.c_str()[0], N_THREADS);
+
+        std::shared_ptr<core::Control<T>> control;
+        if (experiment.dataflow == "WindowFirstOutS")
+            control = std::make_shared<core::WindowFirstOutS<T>>(scheduler, dram, gbuffer, abuffer, pbuffer, wbuffer,
+                    obuffer, composer, ppu);
+        else throw std::runtime_error("Dataflow option not recognized");
+
+        control->setArch(std::make_shared<A>(*std::static_pointer_cast<A>(arch)));
+        controls.emplace_back(control);
+    }
+
+    return controls;
+
+}
+
+template <typename T, typename A>
+std::function<void()> read_job(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::shared_ptr<base::Network<T>> &network,
+        const std::shared_ptr<core::Architecture<T>> &arch, const sys::Shard &shard, uint32_t N_THREADS,
+        bool FAST_MODE, bool QUIET, bool CHECK) {
+
+    auto DNNsim = std::make_shared<core::Simulator<T>>(N_THREADS, FAST_MODE, QUIET, CHECK, shard);
+
+    if (experiment.task == "Cycles") {
+        auto samples = FAST_MODE ? 1 : network->getBatchSize();
+        auto copies = std::min((uint64_t)N_THREADS, samples * network->getNumLayers());
+        auto controls = read_controls<T, A>(simulate, experiment, network->getName(), arch, copies, N_THREADS);
+        return [DNNsim, network, controls]() { DNNsim->run(*network, controls); };
+    } else if (experiment.task == "Potentials")
+        return [DNNsim, network, arch]() { DNNsim->potentials(*network, arch); };
+
+    return nullptr;
+
+}
+
+template <typename T>
+std::function<void()> read_scnn_job(const sys::Batch::Simulate::Experiment &experiment,
+        const std::shared_ptr<base::Network<T>> &network, const sys::Shard &shard, uint32_t N_THREADS,
+        bool FAST_MODE, bool QUIET, bool CHECK) {
+
+    auto arch = std::make_shared<core::SCNN<T>>(experiment.Wt, experiment.Ht, experiment.I, experiment.F,
+            experiment.out_acc_size, experiment.banks, N_THREADS, FAST_MODE, QUIET, shard);
+
+    if (experiment.task == "Cycles")
+        return [arch, network]() { arch->run(*network); };
+    else if (experiment.task == "Potentials") {
+        auto DNNsim = std::make_shared<core::Simulator<T>>(N_THREADS, FAST_MODE, QUIET, CHECK, shard);
+        return [DNNsim, network, arch]() { DNNsim->potentials(*network, arch); };
+    }
+
+    return nullptr;
+
+}
+
+std::function<void()> read_job(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::shared_ptr<base::Network<float>> &network,
+        const sys::Shard &shard, uint32_t N_THREADS, bool FAST_MODE, bool QUIET, bool CHECK) {
+
+    if (experiment.architecture == "SCNN") {
+        return read_scnn_job<float>(experiment, network, shard, N_THREADS, FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "DaDianNao") {
+        std::shared_ptr<core::Architecture<float>> arch = std::make_shared<core::DaDianNao<float>>(experiment.lanes,
+                experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width, experiment.tactical);
+        return read_job<float, core::DaDianNao<float>>(simulate, experiment, network, arch, shard, N_THREADS,
+                FAST_MODE, QUIET, CHECK);
+    }
+
+    return nullptr;
+
+}
+
+std::function<void()> read_job(const sys::Batch::Simulate &simulate,
+        const sys::Batch::Simulate::Experiment &experiment, const std::shared_ptr<base::Network<uint16_t>> &network,
+        const sys::Shard &shard, uint32_t N_THREADS, bool FAST_MODE, bool QUIET, bool CHECK) {
+
+    if (experiment.architecture == "SCNN") {
+        return read_scnn_job<uint16_t>(experiment, network, shard, N_THREADS, FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "DaDianNao") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::DaDianNao<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
+                experiment.tactical);
+        return read_job<uint16_t, core::DaDianNao<uint16_t>>(simulate, experiment, network, arch, shard, N_THREADS,
+                FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "Stripes") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::Stripes<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width);
+        return read_job<uint16_t, core::Stripes<uint16_t>>(simulate, experiment, network, arch, shard, N_THREADS,
+                FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "ShapeShifter") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::ShapeShifter<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
+                experiment.group_size, experiment.column_registers, experiment.minor_bit, experiment.diffy,
+                experiment.tactical);
+        return read_job<uint16_t, core::ShapeShifter<uint16_t>>(simulate, experiment, network, arch, shard,
+                N_THREADS, FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "Loom") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::Loom<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
+                experiment.group_size, experiment.pe_serial_bits, experiment.minor_bit, experiment.dynamic_weights);
+        return read_job<uint16_t, core::Loom<uint16_t>>(simulate, experiment, network, arch, shard, N_THREADS,
+                FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "BitPragmatic") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::BitPragmatic<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
+                experiment.bits_first_stage, experiment.column_registers, experiment.booth, experiment.diffy,
+                experiment.tactical);
+        return read_job<uint16_t, core::BitPragmatic<uint16_t>>(simulate, experiment, network, arch, shard,
+                N_THREADS, FAST_MODE, QUIET, CHECK);
+
+    } else if (experiment.architecture == "Laconic") {
+        std::shared_ptr<core::Architecture<uint16_t>> arch = std::make_shared<core::Laconic<uint16_t>>(
+                experiment.lanes, experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
+                experiment.booth);
+        return read_job<uint16_t, core::Laconic<uint16_t>>(simulate, experiment, network, arch, shard, N_THREADS,
+                FAST_MODE, QUIET, CHECK);
+    }
+
+    return nullptr;
+
+}
+
+std::vector<std::vector<uint64_t>> schedule_experiments(const sys::Batch::Simulate &simulate, uint32_t N_JOBS) {
+
+    std::vector<std::vector<uint64_t>> waves;
+    if (N_JOBS == 1) {
+        for (uint64_t exp = 0; exp < simulate.experiments.size(); ++exp)
+            waves.push_back({exp});
+        return waves;
+    }
+
+    // DRAMSim2 keeps the memory configuration in globals: only experiments with the same DRAM run together
+    std::vector<uint64_t> no_dram;
+    std::map<std::string, uint64_t> wave_idx;
+    for (uint64_t exp = 0; exp < simulate.experiments.size(); ++exp) {
+        const auto &experiment = simulate.experiments[exp];
+        if (experiment.task != "Cycles" || experiment.architecture == "SCNN") {
+            no_dram.push_back(exp);
+            continue;
+        }
+
+        auto dram = experiment.dram_conf + ":" + std::to_string(experiment.dram_size);
+        auto it = wave_idx.find(dram);
+        if (it == wave_idx.end()) {
+            wave_idx[dram] = waves.size();
+            waves.push_back({exp});
+        } else waves[it->second].push_back(exp);
+    }
+
+    if (waves.empty()) waves.emplace_back();
+    waves.front().insert(waves.front().end(), no_dram.begin(), no_dram.end());
+    return waves;
+
+}
+
+template <typename T>
+uint64_t run_experiments(const sys::Batch::Simulate &simulate, const std::shared_ptr<base::Network<T>> &network,
+        const std::vector<sys::Shard> &shards, uint32_t N_JOBS, uint32_t N_THREADS, bool FAST_MODE, bool QUIET,
+        bool CHECK) {
+
+    // Errors are reported as they happen, the caller only gets how many experiments failed
+    uint64_t failed = 0;
+
+    for (const auto &wave : schedule_experiments(simulate, N_JOBS)) {
+
+        // Memory systems are built serially, DRAMSim2 configures them through globals
+        std::vector<std::function<void()>> jobs;
+        for (const auto &exp : wave) {
+            try {
+                auto job = read_job(simulate, simulate.experiments[exp], network, shards[exp], N_THREADS, FAST_MODE,
+                        QUIET, CHECK);
+                if (job) jobs.emplace_back(job);
+            } catch (std::exception &exception) {
+                std::cerr << "Simulation error: " << exception.what() << std::endl;
+                failed++;
+                #ifdef STOP_AFTER_ERROR
+                exit(1);
+                #endif
+            }
+        }
+
+        #pragma omp parallel for num_threads(N_JOBS) schedule(dynamic)
+        for (int job = 0; job < jobs.size(); ++job) {
+            try {
+                jobs[job]();
+            } catch (std::exception &exception) {
+                #pragma omp critical
+                {
+                    std::cerr << "Simulation error: " << exception.what() << std::endl;
+                    failed++;
+                }
+                #ifdef STOP_AFTER_ERROR
+                exit(1);
+                #endif
+            }
+        }
+
+    }
+
+    return failed;
+
+}
+
+template <typename T>
+void run_workers(const sys::Batch::Simulate &simulate, const std::shared_ptr<base::Network<T>> &network,
+        const std::vector<sys::Shard> &shards, uint32_t N_WORKERS, uint32_t N_JOBS, uint32_t N_THREADS,
+        bool FAST_MODE, bool QUIET, bool CHECK) {
+
+    // Buffered messages would be printed again by every worker
+    std::cout.flush();
+    std::cerr.flush();
+
+    // Workers inherit the loaded network copy-on-write and run the experiments round-robin
+    auto workers = std::min((uint64_t)N_WORKERS, (uint64_t)simulate.experiments.size());
+    std::vector<pid_t> pids;
+    for (uint64_t worker = 0; worker < workers; ++worker) {
+
+        pid_t pid = fork();
+        if (pid == -1) {
+            std::cerr << "Error creating worker process " << worker << std::endl;
+            break;
+        }
+
+        if (pid == 0) {
+            int status = 0;
+            try {
+                auto subset = simulate;
+                subset.experiments.clear();
+                std::vector<sys::Shard> subset_shards;
+                for (uint64_t exp = worker; exp < simulate.experiments.size(); exp += workers) {
+                    subset.experiments.push_back(simulate.experiments[exp]);
+                    subset_shards.push_back(shards[exp]);
+                }
+                auto failed = run_experiments(subset, network, subset_shards, N_JOBS, N_THREADS, FAST_MODE, QUIET,
+                        CHECK);
+                status = (int)std::min(failed, (uint64_t)255);
+            } catch (std::exception &exception) {
+                std::cerr << "Simulation error: " << exception.what() << std::endl;
+                status = 1;
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(status);
+        }
+
+        pids.push_back(pid);
+    }
+
+    // Every experiment writes its own results file, the parent waits until all of them are written
+    uint64_t failed = workers - pids.size();
+    for (auto pid : pids) {
+        int status = 0;
+        if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failed++;
+    }
+
+    if (failed > 0)
+        throw std::runtime_error(std::to_string(failed) + " of " + std::to_string(workers) +
+                " worker processes failed for network " + simulate.network);
+
+}
+
+std::string network_key(const sys::Batch::Simulate &simulate) {
+    return simulate.network + ":" + simulate.model + ":" + simulate.data_type + ":" + std::to_string(simulate.batch)
+            + ":" + std::to_string(simulate.data_width) + ":" + std::to_string(simulate.quantised);
+}
+
+sys::Shard parse_shard(const std::string &shard_option) {
+
+    sys::Shard shard;
+    auto slash = shard_option.find('/');
+    try {
+        if (slash == std::string::npos) throw std::invalid_argument(shard_option);
+        shard.index = std::stoul(shard_option.substr(0, slash));
+        shard.count = std::stoul(shard_option.substr(slash + 1));
+    } catch (const std::logic_error &exception) {
+        throw std::runtime_error("Shard must be given as <index>/<count>: " + shard_option);
+    }
+
+    if (shard.count == 0 || shard.index >= shard.count)
+        throw std::runtime_error("Shard index must be lower than the number of shards: " + shard_option);
+
+    return shard;
+
+}
+
 void check_options(const cxxopts::Options &options)
 {
-    if(options.count("batch") == 0) {
+    if (options.count("merge") == 1) {
+        if (options["merge"].as<uint32_t>() < 2)
+            throw std::runtime_error("Number of shards to merge must be at least 2");
+    } else if(options.count("batch") == 0) {
         throw std::runtime_error("Please provide a batch file with instructions. Examples in folder \"examples\"");
     } else {
         std::string batch_path = options["batch"].as<std::string>();
@@ -93,8 +440,18 @@ cxxopts::Options parse_options(int argc, char *argv[]) {
     options.add_options("simulation")
     ("q,quiet", "Don't show stdout progress messages",cxxopts::value<bool>(),"<Boolean>")
     ("fast_mode", "Enable fast mode: simulate only one sample",cxxopts::value<bool>(),"<Boolean>")
+    ("threads", "Number of threads used to simulate the samples in parallel. Default: 1",
+            cxxopts::value<uint32_t>(), "<Positive Number>")
+    ("jobs", "Number of experiments simulated concurrently. Default: 1", cxxopts::value<uint32_t>(),
+            "<Positive Number>")
+    ("workers", "Number of processes the experiments are distributed to after loading the traces. Default: 1",
+            cxxopts::value<uint32_t>(), "<Positive Number>")
     ("check_values", "Check the correctness of the output values of the simulations.", cxxopts::value<bool>(),
-            "<Boolean>");
+            "<Boolean>")
+    ("shard", "Simulate only the layers and samples of this shard and store them as partial results. Default: 0/1",
+            cxxopts::value<std::string>(), "<Index>/<Count>")
+    ("merge", "Merge the partial results of all the shards into the results of a single run",
+            cxxopts::value<uint32_t>(), "<Number of shards>");
 
     options.parse_positional("batch");
 
@@ -116,13 +473,65 @@ int main(int argc, char *argv[]) {
         check_options(options);
 
         bool QUIET = options.count("quiet") == 0 ? false : options["quiet"].as<bool>();
+
+        // Merge the partial results instead of simulating
+        if (options.count("merge") == 1) {
+            auto failed = sys::Stats::merge_partials(options["merge"].as<uint32_t>(), QUIET);
+            if (failed > 0) throw std::runtime_error(std::to_string(failed) + " experiments could not be merged");
+            return 0;
+        }
+
         bool FAST_MODE = options.count("fast_mode") == 0 ? false : options["fast_mode"].as<bool>();
         bool CHECK = options.count("check_values") == 0 ? false : options["check_values"].as<bool>();
+        uint32_t N_THREADS = options.count("threads") == 0 ? 1 : options["threads"].as<uint32_t>();
+        if (N_THREADS == 0 || N_THREADS > UINT8_MAX)
+            throw std::runtime_error("Number of threads must be between 1 and " + std::to_string(UINT8_MAX));
+        uint32_t N_JOBS = options.count("jobs") == 0 ? 1 : options["jobs"].as<uint32_t>();
+        if (N_JOBS == 0)
+            throw std::runtime_error("Number of jobs must be at least 1");
+        uint32_t N_WORKERS = options.count("workers") == 0 ? 1 : options["workers"].as<uint32_t>();
+        if (N_WORKERS == 0)
+            throw std::runtime_error("Number of workers must be at least 1");
+        sys::Shard SHARD = options.count("shard") == 0 ? sys::Shard() :
+                parse_shard(options["shard"].as<std::string>());
+
+        #ifdef _OPENMP
+        // Concurrent experiments can still simulate their samples in parallel
+        if (N_JOBS > 1 && N_THREADS > 1) omp_set_max_active_levels(2);
+        #endif
+
         std::string batch_path = options["batch"].as<std::string>();
         sys::Batch batch = sys::Batch(batch_path);
         batch.read_batch();
 
-        for(const auto &simulate : batch.getSimulations()) {
+        const auto &simulations = batch.getSimulations();
+
+        // Traces are loaded once and shared by all the simulations using them
+        std::map<std::string, uint64_t> last_use;
+        for (uint64_t sim = 0; sim < simulations.size(); ++sim)
+            last_use[network_key(simulations[sim])] = sim;
+
+        std::map<std::string, std::shared_ptr<base::Network<float>>> float_networks;
+        std::map<std::string, std::shared_ptr<base::Network<uint16_t>>> fixed_networks;
+
+        // OpenMP threads do not survive a fork: the parent of the workers must not start any
+        uint32_t LOAD_THREADS = N_WORKERS > 1 ? 1 : N_THREADS;
+
+        // Every experiment of the batch file starts distributing its work units from a different shard
+        uint64_t experiment_offset = 0;
+
+        // Failed experiments do not stop the others, but the exit status reports them
+        uint64_t failed = 0;
+
+        for (uint64_t sim = 0; sim < simulations.size(); ++sim) {
+            const auto &simulate = simulations[sim];
+            auto key = network_key(simulate);
+
+            std::vector<sys::Shard> shards;
+            for (uint64_t exp = 0; exp < simulate.experiments.size(); ++exp) {
+                shards.push_back(SHARD);
+                shards.back().offset = experiment_offset++;
+            }
 
             if(!QUIET) std::cout << "Network: " << simulate.network << std::endl;
 
@@ -130,235 +539,49 @@ int main(int argc, char *argv[]) {
 
                 // Inference traces
                 if (simulate.data_type == "Float") {
-                    auto network = read<float>(simulate, QUIET);
-                    for(const auto &experiment : simulate.experiments) {
-
-                        auto tracked_data = std::make_shared<std::map<uint64_t, uint32_t>>();
-                        auto act_addresses = std::make_shared<core::AddressRange>();
-                        auto out_addresses = std::make_shared<core::AddressRange>();
-                        auto wgt_addresses = std::make_shared<core::AddressRange>();
-
-                        auto dram = std::make_shared<core::DRAM<float>>(tracked_data, act_addresses, out_addresses,
-                                wgt_addresses, experiment.dram_width, experiment.dram_size, simulate.data_width,
-                                experiment.cpu_clock_freq, experiment.dram_start_act_address,
-                                experiment.dram_start_wgt_address, experiment.dram_conf, "system.ini", network.getName());
-
-                        auto gbuffer = std::make_shared<core::GlobalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.gbuffer_act_levels,
-                                experiment.gbuffer_wgt_levels, experiment.gbuffer_act_size, experiment.gbuffer_wgt_size,
-                                experiment.gbuffer_act_banks, experiment.gbuffer_wgt_banks,
-                                experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width,
-                                experiment.dram_width, experiment.gbuffer_act_read_delay,
-                                experiment.gbuffer_act_write_delay, experiment.gbuffer_wgt_read_delay,
-                                experiment.gbuffer_act_eviction_policy, experiment.gbuffer_wgt_eviction_policy);
-
-                        auto abuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.abuffer_rows, experiment.abuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto pbuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.pbuffer_rows, experiment.pbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto wbuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.wbuffer_rows, experiment.wbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto obuffer = std::make_shared<core::LocalBuffer<float>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.obuffer_rows, core::NULL_DELAY,
-                                experiment.obuffer_write_delay);
-
-                        auto composer = std::make_shared<core::Composer<float>>(experiment.composer_inputs,
-                                experiment.composer_delay);
-
-                        auto ppu = std::make_shared<core::PPU<float>>(experiment.ppu_inputs, experiment.ppu_delay);
-
-                        auto scheduler = std::make_shared<core::BitTactical<float>>(experiment.lookahead_h,
-                                experiment.lookaside_d, experiment.search_shape.c_str()[0]);
-
-                        std::shared_ptr<core::Control<float>> control;
-                        if (experiment.dataflow == "WindowFirstOutS")
-                            control = std::make_shared<core::WindowFirstOutS<float>>(scheduler, dram, gbuffer, abuffer,
-                                    pbuffer, wbuffer, obuffer, composer, ppu);
-
-                        core::Simulator<float> DNNsim(FAST_MODE, QUIET, CHECK);
-
-                        if (experiment.architecture == "SCNN") {
-                            std::shared_ptr<core::Architecture<float>> arch =
-                                    std::make_shared<core::SCNN<float>>(experiment.Wt, experiment.Ht, experiment.I,
-                                    experiment.F, experiment.out_acc_size, experiment.banks, FAST_MODE, QUIET);
-
-                            if (experiment.task == "Cycles")
-                                std::static_pointer_cast<core::SCNN<float>>(arch)->run(network);
-                            else if (experiment.task == "Potentials") DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "DaDianNao") {
-                            std::shared_ptr<core::Architecture<float>> arch =
-                                    std::make_shared<core::DaDianNao<float>>(experiment.lanes, experiment.columns,
-                                    experiment.rows, experiment.tiles, experiment.pe_width,  experiment.tactical);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-                        }
-                    }
+                    if (float_networks.find(key) == float_networks.end())
+                        float_networks[key] = std::make_shared<base::Network<float>>(read<float>(simulate,
+                                LOAD_THREADS, QUIET));
+
+                    if (N_WORKERS > 1)
+                        run_workers(simulate, float_networks[key], shards, N_WORKERS, N_JOBS, N_THREADS, FAST_MODE,
+                                QUIET, CHECK);
+                    else
+                        failed += run_experiments(simulate, float_networks[key], shards, N_JOBS, N_THREADS, FAST_MODE,
+                                QUIET, CHECK);
 
                 } else if (simulate.data_type == "Fixed") {
-                    base::Network<uint16_t> network;
-                    {
+                    if (fixed_networks.find(key) == fixed_networks.end()) {
                         base::Network<float> tmp_network;
-                        tmp_network = read<float>(simulate, QUIET);
-                        network = tmp_network.fixed_point();
+                        tmp_network = read<float>(simulate, LOAD_THREADS, QUIET);
+                        fixed_networks[key] = std::make_shared<base::Network<uint16_t>>(
+                                tmp_network.fixed_point(LOAD_THREADS));
                     }
 
-                    for (const auto &experiment : simulate.experiments) {
-
-                        auto tracked_data = std::make_shared<std::map<uint64_t, uint32_t>>();
-                        auto act_addresses = std::make_shared<core::AddressRange>();
-                        auto out_addresses = std::make_shared<core::AddressRange>();
-                        auto wgt_addresses = std::make_shared<core::AddressRange>();
-
-                        auto dram = std::make_shared<core::DRAM<uint16_t>>(tracked_data, act_addresses, out_addresses,
-                                wgt_addresses, experiment.dram_width, experiment.dram_size, simulate.data_width,
-                                experiment.cpu_clock_freq, experiment.dram_start_act_address,
-                                experiment.dram_start_wgt_address, experiment.dram_conf, "system.ini", network.getName());
-
-                        auto gbuffer = std::make_shared<core::GlobalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.gbuffer_act_levels,
-                                experiment.gbuffer_wgt_levels, experiment.gbuffer_act_size, experiment.gbuffer_wgt_size,
-                                experiment.gbuffer_act_banks, experiment.gbuffer_wgt_banks,
-                                experiment.gbuffer_act_bank_width, experiment.gbuffer_wgt_bank_width,
-                                experiment.dram_width, experiment.gbuffer_act_read_delay,
-                                experiment.gbuffer_act_write_delay, experiment.gbuffer_wgt_read_delay,
-                                experiment.gbuffer_act_eviction_policy, experiment.gbuffer_wgt_eviction_policy);
-
-                        auto abuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.abuffer_rows, experiment.abuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto pbuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.pbuffer_rows, experiment.pbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto wbuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.wbuffer_rows, experiment.wbuffer_read_delay,
-                                core::NULL_DELAY);
-
-                        auto obuffer = std::make_shared<core::LocalBuffer<uint16_t>>(tracked_data, act_addresses,
-                                out_addresses, wgt_addresses, experiment.obuffer_rows, core::NULL_DELAY,
-                                experiment.obuffer_write_delay);
-
-                        auto composer = std::make_shared<core::Composer<uint16_t>>(experiment.composer_inputs,
-                                experiment.composer_delay);
-
-                        auto ppu = std::make_shared<core::PPU<uint16_t>>(experiment.ppu_inputs, experiment.ppu_delay);
-
-                        auto scheduler = std::make_shared<core::BitTactical<uint16_t>>(experiment.lookahead_h,
-                                experiment.lookaside_d, experiment.search_shape.c_str()[0]);
-
-                        std::shared_ptr<core::Control<uint16_t>> control;
-                        if (experiment.dataflow == "WindowFirstOutS")
-                            control = std::make_shared<core::WindowFirstOutS<uint16_t>>(scheduler, dram, gbuffer,
-                                    abuffer, pbuffer, wbuffer, obuffer, composer, ppu);
-
-                        core::Simulator<uint16_t> DNNsim(FAST_MODE, QUIET, CHECK);
-
-                        if (experiment.architecture == "SCNN") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::SCNN<uint16_t>>(experiment.Wt, experiment.Ht, experiment.I,
-                                    experiment.F, experiment.out_acc_size, experiment.banks, FAST_MODE, QUIET);
-
-                            if (experiment.task == "Cycles")
-                                std::static_pointer_cast<core::SCNN<uint16_t>>(arch)->run(network);
-                            else if (experiment.task == "Potentials") DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "DaDianNao") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::DaDianNao<uint16_t>>(experiment.lanes,
-                                    experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
-                                    experiment.tactical);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "Stripes") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::Stripes<uint16_t>>(experiment.lanes, experiment.columns,
-                                    experiment.rows, experiment.tiles, experiment.pe_width);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "ShapeShifter") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::ShapeShifter<uint16_t>>(experiment.lanes,
-                                    experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
-                                    experiment.group_size, experiment.column_registers, experiment.minor_bit,
-                                    experiment.diffy, experiment.tactical);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "Loom") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::Loom<uint16_t>>(experiment.lanes, experiment.columns,
-                                    experiment.rows, experiment.tiles, experiment.pe_width, experiment.group_size,
-                                    experiment.pe_serial_bits, experiment.minor_bit, experiment.dynamic_weights);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "BitPragmatic") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::BitPragmatic<uint16_t>>(experiment.lanes,
-                                    experiment.columns, experiment.rows, experiment.tiles, experiment.pe_width,
-                                    experiment.bits_first_stage, experiment.column_registers, experiment.booth,
-                                    experiment.diffy, experiment.tactical);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        } else if (experiment.architecture == "Laconic") {
-                            std::shared_ptr<core::Architecture<uint16_t>> arch =
-                                    std::make_shared<core::Laconic<uint16_t>>(experiment.lanes, experiment.columns,
-                                    experiment.rows, experiment.tiles, experiment.pe_width, experiment.booth);
-
-                            if (experiment.task == "Cycles") {
-                                control->setArch(arch);
-                                DNNsim.run(network, control);
-                            } else if (experiment.task == "Potentials")
-                                DNNsim.potentials(network, arch);
-
-                        }
-
-                    }
+                    if (N_WORKERS > 1)
+                        run_workers(simulate, fixed_networks[key], shards, N_WORKERS, N_JOBS, N_THREADS, FAST_MODE,
+                                QUIET, CHECK);
+                    else
+                        failed += run_experiments(simulate, fixed_networks[key], shards, N_JOBS, N_THREADS, FAST_MODE,
+                                QUIET, CHECK);
                 }
-            
-			} catch (std::exception &exception) {
+
+            } catch (std::exception &exception) {
                 std::cerr << "Simulation error: " << exception.what() << std::endl;
+                failed++;
                 #ifdef STOP_AFTER_ERROR
                 exit(1);
                 #endif
             }
+
+            if (last_use[key] == sim) {
+                float_networks.erase(key);
+                fixed_networks.erase(key);
+            }
         }
 
+        if (failed > 0) return 1;
+
     } catch (std::exception &exception) {
         std::cerr << "Error: " << exception.what() << std::endl;
         exit(1);
@@ -158,6 +158,39 @@ namespace sys {
         Special
     };
 
+    /**
+     * Work units of the experiments simulated by this process. The (sample, layer) units of every experiment are
+     * distributed round-robin among the shards, each experiment starting from a different shard.
+     */
+    struct Shard
+    {
+
+        /**
+         * Index of this shard
+         */
+        uint32_t index = 0;
+
+        /**
+         * Number of shards
+         */
+        uint32_t count = 1;
+
+        /**
+         * Position of the experiment in the batch file
+         */
+        uint64_t offset = 0;
+
+        /**
+         * Check if a work unit of the experiment belongs to this shard
+         * @param unit Index of the unit: sample * layers + layer
+         * @return True if this shard simulates the unit
+         */
+        bool owns(uint64_t unit) const {
+            return (offset + unit) % count == index;
+        }
+
+    };
+
     /**
      * Abstract data type for the statistics.
      */
@@ -231,6 +264,21 @@ namespace sys {
          */
         virtual std::string dist_to_string() = 0;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer, used for the partial results
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        virtual std::string to_raw(uint64_t layer, uint64_t sample) = 0;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer from the partial results
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        virtual void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) = 0;
+
     };
 
     /**
@@ -290,6 +338,21 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        std::string to_raw(uint64_t layer, uint64_t sample) override;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) override;
+
     };
 
     /**
@@ -348,6 +411,21 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        std::string to_raw(uint64_t layer, uint64_t sample) override;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) override;
+
     };
 
     /**
@@ -406,6 +484,21 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        std::string to_raw(uint64_t layer, uint64_t sample) override;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) override;
+
     };
 
     /**
@@ -477,6 +570,21 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        std::string to_raw(uint64_t layer, uint64_t sample) override;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) override;
+
     };
 
     /**
@@ -548,6 +656,21 @@ namespace sys {
          */
         std::string dist_to_string() override;
 
+        /**
+         * Return the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         */
+        std::string to_raw(uint64_t layer, uint64_t sample) override;
+
+        /**
+         * Read the exact values of the stat for specific sample and layer
+         * @param layer Index for the layer
+         * @param sample Index for the sample
+         * @param raw Values as returned by to_raw
+         */
+        void from_raw(uint64_t layer, uint64_t sample, const std::string &raw) override;
+
     };
 
     /**
@@ -574,6 +697,26 @@ namespace sys {
              */
             std::shared_ptr<sys::stat_base_t> var;
 
+            /**
+             * Stats whose totals give the special value: offset + scale * total(numerator) / total(denominator)
+             */
+            int64_t special_numerator = -1;
+
+            /**
+             * Denominator of the special value
+             */
+            int64_t special_denominator = -1;
+
+            /**
+             * Offset of the special value
+             */
+            double special_offset = 0.0;
+
+            /**
+             * Scale of the special value
+             */
+            double special_scale = 1.0;
+
             ~table_t() = default;
 
         };
@@ -604,6 +747,29 @@ namespace sys {
          */
         static void check_path(const std::string &path);
 
+        /**
+         * Create the results folder for the network if it does not exist
+         * @param network_name Name of the network
+         * @return Path of the folder
+         */
+        static std::string results_path(const std::string &network_name);
+
+        /**
+         * Return the index of a stat in the database
+         * @param stat Registered stat
+         * @return Index of the stat
+         */
+        int64_t find(const std::shared_ptr<stat_base_t> &stat) const;
+
+        /**
+         * Merge the partial results of all the shards in a csv file
+         * @param network_name Name of the network
+         * @param filename Name of the file
+         * @param shards Number of shards
+         * @param QUIET Avoid std::out messages
+         */
+        static void merge(const std::string &network_name, const std::string &filename, uint32_t shards, bool QUIET);
+
     public:
 
         /**
@@ -687,6 +853,38 @@ namespace sys {
         void dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
                 const std::string &header, bool QUIET);
 
+        /**
+         * Define the special value of a stat as offset + scale * total(numerator) / total(denominator), so it can be
+         * computed again once the partial results are merged
+         * @param stat Special stat
+         * @param numerator Stat for the numerator
+         * @param denominator Stat for the denominator
+         * @param offset Offset of the value
+         * @param scale Scale of the ratio
+         */
+        void set_special_ratio(const std::shared_ptr<stat_base_t> &stat, const std::shared_ptr<stat_uint_t> &numerator,
+                const std::shared_ptr<stat_uint_t> &denominator, double offset, double scale);
+
+        /**
+         * Return the exact stats of the work units of a shard in a partial results file
+         * @param network_name Name of the network
+         * @param layers_name Name of the layers
+         * @param header Header for the results
+         * @param shard Work units simulated
+         * @param QUIET Avoid std::out messages
+         */
+        void dump_partial(const std::string &network_name, const std::vector<std::string> &layers_name,
+                const std::string &header, const Shard &shard, bool QUIET);
+
+        /**
+         * Merge the partial results of every shard found in the results folder into the csv files a single run
+         * would have written
+         * @param shards Number of shards
+         * @param QUIET Avoid std::out messages
+         * @return Number of experiments that could not be merged
+         */
+        static uint64_t merge_partials(uint32_t shards, bool QUIET);
+
     };
 
 } //namespace sim
@@ -1,9 +1,23 @@
 
 #include <sys/Stats.h>
 #include <sys/stat.h>
+#include <dirent.h>
+#include <cerrno>
+#include <limits>
 
 namespace sys {
 
+    /**
+     * Return a double with enough digits to read back the same value
+     * @param value Double value
+     * @return Exact string of the value
+     */
+    static std::string exact_string(double value) {
+        std::ostringstream stream;
+        stream << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+        return stream.str();
+    }
+
     //stat_base_t
 
     stat_base_t::stat_base_t() : measure(No_Measure), special_value(0.0), skip_first(false) {}
@@ -38,6 +52,14 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    std::string stat_string_t::to_raw(uint64_t layer, uint64_t sample) {
+        return value[layer][sample];
+    }
+
+    void stat_string_t::from_raw(uint64_t layer, uint64_t sample, const std::string &raw) {
+        value[layer][sample] = raw;
+    }
+
     // stat_uint_t
 
     stat_uint_t::stat_uint_t(uint64_t _layers, uint64_t _batch_size, uint64_t _value, Measure _measure,
@@ -83,6 +105,14 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    std::string stat_uint_t::to_raw(uint64_t layer, uint64_t sample) {
+        return std::to_string(value[layer][sample]);
+    }
+
+    void stat_uint_t::from_raw(uint64_t layer, uint64_t sample, const std::string &raw) {
+        value[layer][sample] = std::stoull(raw);
+    }
+
     // stat_double_t
 
     stat_double_t::stat_double_t(uint64_t _layers, uint64_t _batch_size, double _value, Measure _measure,
@@ -128,6 +158,14 @@ namespace sys {
         throw std::runtime_error("Wrong stat type");
     }
 
+    std::string stat_double_t::to_raw(uint64_t layer, uint64_t sample) {
+        return exact_string(value[layer][sample]);
+    }
+
+    void stat_double_t::from_raw(uint64_t layer, uint64_t sample, const std::string &raw) {
+        value[layer][sample] = std::strtod(raw.c_str(), nullptr);
+    }
+
     // stat_uint_dist_t
 
     stat_uint_dist_t::stat_uint_dist_t() : min_range(0), max_range(0) {}
@@ -198,6 +236,25 @@ namespace sys {
         return line;
     }
 
+    std::string stat_uint_dist_t::to_raw(uint64_t layer, uint64_t sample) {
+        std::string line;
+        for (const auto &_value : value) {
+            line += std::to_string(_value[layer][sample]) + ' ';
+        }
+        line = line.substr(0, line.size() - 1);
+        return line;
+    }
+
+    void stat_uint_dist_t::from_raw(uint64_t layer, uint64_t sample, const std::string &raw) {
+        std::istringstream stream(raw);
+        std::string token;
+        for (auto &_value : value) {
+            if (!(stream >> token))
+                throw std::runtime_error("Missing values in the distribution");
+            _value[layer][sample] = std::stoull(token);
+        }
+    }
+
     // stat_double_dist_t
 
     stat_double_dist_t::stat_double_dist_t() : min_range(0), max_range(0) {}
@@ -267,6 +324,25 @@ namespace sys {
         return line;
     }
 
+    std::string stat_double_dist_t::to_raw(uint64_t layer, uint64_t sample) {
+        std::string line;
+        for (const auto &_value : value) {
+            line += exact_string(_value[layer][sample]) + ' ';
+        }
+        line = line.substr(0, line.size() - 1);
+        return line;
+    }
+
+    void stat_double_dist_t::from_raw(uint64_t layer, uint64_t sample, const std::string &raw) {
+        std::istringstream stream(raw);
+        std::string token;
+        for (auto &_value : value) {
+            if (!(stream >> token))
+                throw std::runtime_error("Missing values in the distribution");
+            _value[layer][sample] = std::strtod(token.c_str(), nullptr);
+        }
+    }
+
     // Stats
 
     Stats::Stats(uint64_t _layers, uint64_t _batch_size, const std::string &_filename) : layers(_layers),
@@ -332,26 +408,58 @@ namespace sys {
         return std::dynamic_pointer_cast<stat_double_dist_t>(table.var);
     }
 
-    void Stats::dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
-            const std::string &header, bool QUIET) {
-
-        std::ofstream o_file;
+    std::string Stats::results_path(const std::string &network_name) {
 
         try {
             check_path("results");
         } catch (const std::exception &exception) {
-            if (mkdir("results", 0775) == -1)
+            if (mkdir("results", 0775) == -1 && errno != EEXIST)
                 throw std::runtime_error("Error creating folder results");
         }
 
         try {
             check_path("results/" + network_name);
         } catch (const std::exception &exception) {
-            if (mkdir(("results/" + network_name).c_str(), 0775) == -1)
+            if (mkdir(("results/" + network_name).c_str(), 0775) == -1 && errno != EEXIST)
                 throw std::runtime_error("Error creating folder results/" + network_name);
         }
 
-        std::string path = "results/" + network_name + "/" + filename + ".csv";
+        return "results/" + network_name;
+    }
+
+    int64_t Stats::find(const std::shared_ptr<stat_base_t> &stat) const {
+        for (uint64_t idx = 0; idx < database.size(); ++idx) {
+            if (database[idx].var == stat)
+                return idx;
+        }
+        throw std::runtime_error("Stat not registered in " + filename);
+    }
+
+    void Stats::set_special_ratio(const std::shared_ptr<stat_base_t> &stat,
+            const std::shared_ptr<stat_uint_t> &numerator, const std::shared_ptr<stat_uint_t> &denominator,
+            double offset, double scale) {
+        auto &table = database[find(stat)];
+        table.special_numerator = find(numerator);
+        table.special_denominator = find(denominator);
+        table.special_offset = offset;
+        table.special_scale = scale;
+    }
+
+    void Stats::dump_csv(const std::string &network_name, const std::vector<std::string> &layers_name,
+            const std::string &header, bool QUIET) {
+
+        std::ofstream o_file;
+
+        // Special values defined by other stats are computed from the complete results
+        for (const auto &table : database) {
+            if (table.special_numerator < 0) continue;
+            auto numerator = std::dynamic_pointer_cast<stat_uint_t>(database[table.special_numerator].var);
+            auto denominator = std::dynamic_pointer_cast<stat_uint_t>(database[table.special_denominator].var);
+            table.var->special_value = table.special_offset + table.special_scale *
+                    (get_total(numerator->value) / (double)get_total(denominator->value));
+        }
+
+        std::string path = results_path(network_name) + "/" + filename + ".csv";
         o_file.open (path);
 
         o_file << std::endl << header << std::endl;
@@ -454,4 +562,232 @@ namespace sys {
         if (!QUIET) std::cout << "Results stored in: " << path << std::endl;
     }
 
-}
\ No newline at end of file
+    void Stats::dump_partial(const std::string &network_name, const std::vector<std::string> &layers_name,
+            const std::string &header, const Shard &shard, bool QUIET) {
+
+        std::string path = results_path(network_name) + "/" + filename + ".shard_" + std::to_string(shard.index) +
+                "_of_" + std::to_string(shard.count);
+        std::ofstream o_file(path);
+
+        o_file << "DNNsim partial results" << std::endl;
+        o_file << shard.index << ' ' << shard.count << ' ' << batch_size << ' ' << layers << std::endl;
+        for (const auto &layer_name : layers_name)
+            o_file << layer_name << std::endl;
+        o_file << header.size() << std::endl << header << std::endl;
+
+        // Definition of the stats: type, measure, skip first, range, special value and name
+        o_file << database.size() << std::endl;
+        for (const auto &table : database) {
+            std::string type;
+            int64_t min_range = 0, max_range = 0;
+            if (std::dynamic_pointer_cast<stat_string_t>(table.var)) {
+                type = "string";
+            } else if (std::dynamic_pointer_cast<stat_uint_t>(table.var)) {
+                type = "uint";
+            } else if (std::dynamic_pointer_cast<stat_double_t>(table.var)) {
+                type = "double";
+            } else if (auto dist = std::dynamic_pointer_cast<stat_uint_dist_t>(table.var)) {
+                type = "uint_dist";
+                min_range = dist->min_range;
+                max_range = dist->max_range;
+            } else if (auto dist = std::dynamic_pointer_cast<stat_double_dist_t>(table.var)) {
+                type = "double_dist";
+                min_range = dist->min_range;
+                max_range = dist->max_range;
+            } else {
+                throw std::runtime_error("Wrong stat type");
+            }
+
+            o_file << type << ' ' << table.var->measure << ' ' << table.var->skip_first << ' ' << min_range << ' '
+                   << max_range << ' ' << table.special_numerator << ' ' << table.special_denominator << ' '
+                   << exact_string(table.special_offset) << ' ' << exact_string(table.special_scale) << ' '
+                   << table.name << std::endl;
+        }
+
+        // Values of the work units of the shard, one stat per line
+        uint64_t units = 0;
+        for (uint64_t unit = 0; unit < batch_size * layers; ++unit) {
+            if (shard.owns(unit)) units++;
+        }
+
+        o_file << units << std::endl;
+        for (uint64_t sample = 0; sample < batch_size; ++sample) {
+            for (uint64_t layer = 0; layer < layers; ++layer) {
+                if (!shard.owns(sample * layers + layer)) continue;
+                o_file << layer << ' ' << sample << std::endl;
+                for (const auto &table : database)
+                    o_file << table.var->to_raw(layer, sample) << std::endl;
+            }
+        }
+
+        o_file.close();
+
+        if (!QUIET) std::cout << "Partial results stored in: " << path << std::endl;
+    }
+
+    void Stats::merge(const std::string &network_name, const std::string &filename, uint32_t shards, bool QUIET) {
+
+        std::shared_ptr<Stats> stats;
+        std::vector<std::string> layers_name;
+        std::string header;
+        std::vector<uint32_t> covered;
+
+        for (uint32_t index = 0; index < shards; ++index) {
+
+            std::string path = "results/" + network_name + "/" + filename + ".shard_" + std::to_string(index) +
+                    "_of_" + std::to_string(shards);
+            std::ifstream i_file(path);
+            if (!i_file.good())
+                throw std::runtime_error("The partial results " + path + " do not exist.");
+
+            std::string line;
+            auto next_line = [&]() -> std::string & {
+                if (!std::getline(i_file, line))
+                    throw std::runtime_error("The partial results " + path + " are incomplete.");
+                return line;
+            };
+
+            if (next_line() != "DNNsim partial results")
+                throw std::runtime_error("The file " + path + " does not contain partial results.");
+
+            uint32_t shard_index, shard_count;
+            uint64_t batch_size, layers;
+            std::istringstream(next_line()) >> shard_index >> shard_count >> batch_size >> layers;
+            if (shard_index != index || shard_count != shards)
+                throw std::runtime_error("The partial results " + path + " belong to another shard.");
+
+            std::vector<std::string> shard_layers_name;
+            for (uint64_t layer = 0; layer < layers; ++layer)
+                shard_layers_name.push_back(next_line());
+
+            auto header_size = std::stoull(next_line());
+            std::string shard_header(header_size, '\0');
+            i_file.read(&shard_header[0], header_size);
+            next_line();
+
+            auto num_stats = std::stoull(next_line());
+            std::vector<std::string> definitions;
+            for (uint64_t idx = 0; idx < num_stats; ++idx)
+                definitions.push_back(next_line());
+
+            // The first shard defines the stats, the others must have been simulated with the same configuration
+            if (index == 0) {
+                stats = std::make_shared<Stats>(layers, batch_size, filename);
+                layers_name = shard_layers_name;
+                header = shard_header;
+                covered = std::vector<uint32_t>(layers * batch_size, 0);
+
+                for (const auto &definition : definitions) {
+                    std::istringstream stream(definition);
+                    std::string type, name;
+                    int measure;
+                    bool skip_first;
+                    int64_t min_range, max_range;
+                    table_t table;
+                    stream >> type >> measure >> skip_first >> min_range >> max_range >> table.special_numerator >>
+                           table.special_denominator >> table.special_offset >> table.special_scale;
+                    std::getline(stream >> std::ws, name);
+
+                    std::shared_ptr<stat_base_t> var;
+                    if (type == "string")
+                        var = stats->register_string_t(name, (Measure)measure, skip_first);
+                    else if (type == "uint")
+                        var = stats->register_uint_t(name, 0, (Measure)measure, skip_first);
+                    else if (type == "double")
+                        var = stats->register_double_t(name, 0, (Measure)measure, skip_first);
+                    else if (type == "uint_dist")
+                        var = stats->register_uint_dist_t(name, min_range, max_range, 0, (Measure)measure,
+                                skip_first);
+                    else if (type == "double_dist")
+                        var = stats->register_double_dist_t(name, min_range, max_range, 0, (Measure)measure,
+                                skip_first);
+                    else
+                        throw std::runtime_error("Wrong stat type " + type + " in " + path);
+
+                    auto &registered = stats->database.back();
+                    registered.special_numerator = table.special_numerator;
+                    registered.special_denominator = table.special_denominator;
+                    registered.special_offset = table.special_offset;
+                    registered.special_scale = table.special_scale;
+                }
+
+            } else if (batch_size != stats->batch_size || layers != stats->layers ||
+                    shard_layers_name != layers_name || shard_header != header ||
+                    num_stats != stats->database.size()) {
+                throw std::runtime_error("The partial results " + path + " do not match the first shard.");
+            }
+
+            auto units = std::stoull(next_line());
+            for (uint64_t unit = 0; unit < units; ++unit) {
+                uint64_t layer = layers, sample = batch_size;
+                std::istringstream(next_line()) >> layer >> sample;
+                if (layer >= layers || sample >= batch_size)
+                    throw std::runtime_error("Wrong work unit in the partial results " + path);
+                covered[sample * layers + layer]++;
+
+                for (auto &table : stats->database)
+                    table.var->from_raw(layer, sample, next_line());
+            }
+        }
+
+        for (uint64_t unit = 0; unit < covered.size(); ++unit) {
+            if (covered[unit] != 1)
+                throw std::runtime_error("Layer " + layers_name[unit % stats->layers] + " sample " +
+                        std::to_string(unit / stats->layers) + " is simulated by " + std::to_string(covered[unit]) +
+                        " shards in the partial results of " + filename);
+        }
+
+        stats->dump_csv(network_name, layers_name, header, QUIET);
+    }
+
+    uint64_t Stats::merge_partials(uint32_t shards, bool QUIET) {
+
+        // An experiment may have failed in some shards, so it is found by the partial results of any of them
+        std::string suffix = "_of_" + std::to_string(shards);
+        std::set<std::pair<std::string, std::string>> results;
+
+        DIR *results_dir = opendir("results");
+        if (results_dir == nullptr)
+            throw std::runtime_error("The path results does not exist.");
+
+        while (auto network_entry = readdir(results_dir)) {
+            std::string network_name = network_entry->d_name;
+            if (network_name == "." || network_name == "..") continue;
+
+            DIR *network_dir = opendir(("results/" + network_name).c_str());
+            if (network_dir == nullptr) continue;
+
+            while (auto file_entry = readdir(network_dir)) {
+                std::string file = file_entry->d_name;
+                auto shard_pos = file.rfind(".shard_");
+                if (shard_pos == std::string::npos || file.size() <= suffix.size() ||
+                        file.compare(file.size() - suffix.size(), suffix.size(), suffix) != 0)
+                    continue;
+
+                auto index = file.substr(shard_pos + 7, file.size() - suffix.size() - shard_pos - 7);
+                if (!index.empty() && index.find_first_not_of("0123456789") == std::string::npos &&
+                        std::stoull(index) < shards)
+                    results.emplace(network_name, file.substr(0, shard_pos));
+            }
+            closedir(network_dir);
+        }
+        closedir(results_dir);
+
+        if (results.empty())
+            throw std::runtime_error("No partial results found in the folder results");
+
+        // A failed experiment does not stop the others from being merged
+        uint64_t failed = 0;
+        for (const auto &result : results) {
+            try {
+                merge(result.first, result.second, shards, QUIET);
+            } catch (std::exception &exception) {
+                std::cerr << "Merge error: " << exception.what() << std::endl;
+                failed++;
+            }
+        }
+
+        return failed;
+    }
+
+}
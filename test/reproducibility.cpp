@@ -0,0 +1,427 @@
+
+#include <base/cnpy.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/* Checks that the statistics of a simulation do not depend on how the work is split: the same batch simulated with
+ * one or several threads, or in shards merged afterwards, must write byte-identical results. */
+
+/** Network with a strided first layer, a padded layer, a pointwise layer and a fully connected layer */
+struct TestLayer {
+    std::string name;
+    std::string type;
+    int stride;
+    int padding;
+    std::vector<size_t> act_shape;
+    std::vector<size_t> wgt_shape;
+};
+
+const std::string NETWORK = "tiny";
+const size_t BATCH = 4;
+
+const std::vector<TestLayer> LAYERS = {
+    {"conv1", "conv", 2, 1, {BATCH, 3, 12, 12}, {8, 3, 3, 3}},
+    {"conv2", "conv", 1, 1, {BATCH, 8, 6, 6}, {16, 8, 3, 3}},
+    {"conv3", "conv", 1, 0, {BATCH, 16, 6, 6}, {16, 16, 1, 1}},
+    {"fc1", "fc", 1, 0, {BATCH, 576}, {10, 576}}
+};
+
+/**
+ * Write random values with zeros, the same ones every time
+ * @param path      File path
+ * @param shape     Shape of the values
+ * @param sparsity  Fraction of zero values
+ * @param min       Minimum value
+ * @param max       Maximum value
+ * @param generator Random generator
+ */
+void write_trace(const std::string &path, const std::vector<size_t> &shape, double sparsity, float min, float max,
+        std::mt19937 &generator) {
+    size_t size = 1;
+    for (auto dim : shape) size *= dim;
+
+    std::uniform_real_distribution<double> zero(0, 1);
+    std::uniform_int_distribution<int> value(0, 1000);
+    std::vector<float> data(size);
+    for (auto &val : data)
+        val = zero(generator) < sparsity ? 0 : min + (max - min) * value(generator) / 1000.f;
+
+    base::npy_save(path, data.data(), shape);
+}
+
+/** Write the model and the traces of the network in the working directory */
+void write_network() {
+    for (const auto &dir : {"models", "net_traces"}) {
+        mkdir(dir, 0755);
+        mkdir((std::string(dir) + "/" + NETWORK).c_str(), 0755);
+    }
+
+    std::ofstream model("models/" + NETWORK + "/model.csv");
+    std::mt19937 generator(1);
+    for (const auto &layer : LAYERS) {
+        model << layer.name << "," << layer.type << "," << layer.stride << "," << layer.padding << "\n";
+        write_trace("net_traces/" + NETWORK + "/act-" + layer.name + "-0.npy", layer.act_shape, 0.4, 0, 4,
+                generator);
+        write_trace("net_traces/" + NETWORK + "/wgt-" + layer.name + ".npy", layer.wgt_shape, 0.3, -1, 1,
+                generator);
+    }
+}
+
+/**
+ * Return an experiment of the batch file
+ * @param architecture  Architecture name
+ * @param options       Options specific to the architecture
+ * @param act_size      Size of the activation global buffer
+ * @param wgt_size      Size of the weight global buffer
+ * @param dram_size     Size of the DRAM
+ * @return Experiment definition
+ */
+std::string experiment(const std::string &architecture, const std::string &options, const std::string &act_size,
+        const std::string &wgt_size, const std::string &dram_size) {
+    return "    experiment {\n"
+           "        architecture: \"" + architecture + "\"\n"
+           "        task: \"Cycles\"\n"
+           "        dataflow: \"WindowFirstOutS\"\n"
+           "        lanes: 16\n"
+           "        columns: 16\n"
+           "        rows: 4\n"
+           "        tiles: 2\n"
+           "        pe_width: 16\n"
+           "        cpu_clock_freq: \"1GHz\"\n"
+           "        dram_conf: \"DDR4_3200\"\n"
+           "        dram_size: \"" + dram_size + "\"\n"
+           "        dram_start_act_address: 0x80000000\n"
+           "        dram_start_wgt_address: 0x00000000\n"
+           "        gbuffer_act_levels: 1\n"
+           "        gbuffer_wgt_levels: 1\n"
+           "        gbuffer_act_size: \"" + act_size + "\"\n"
+           "        gbuffer_wgt_size: \"" + wgt_size + "\"\n"
+           "        gbuffer_act_banks: 32\n"
+           "        gbuffer_wgt_banks: 256\n"
+           "        gbuffer_act_bank_width: 256\n"
+           "        gbuffer_wgt_bank_width: 256\n"
+           "        gbuffer_act_read_delay: 2\n"
+           "        gbuffer_act_write_delay: 2\n"
+           "        gbuffer_wgt_read_delay: 2\n"
+           "        abuffer_rows: 2\n"
+           "        abuffer_read_delay: 1\n"
+           "        wbuffer_rows: 2\n"
+           "        wbuffer_read_delay: 1\n"
+           "        obuffer_rows: 2\n"
+           "        obuffer_write_delay: 1\n"
+           "        composer_inputs: 256\n"
+           "        composer_delay: 1\n"
+           "        ppu_inputs: 16\n"
+           "        ppu_delay: 1\n" + options +
+           "    }\n";
+}
+
+/**
+ * Return a potentials experiment of the batch file
+ * @param architecture  Architecture name
+ * @param options       Options specific to the architecture
+ * @return Experiment definition
+ */
+std::string potentials(const std::string &architecture, const std::string &options) {
+    return "    experiment {\n"
+           "        architecture: \"" + architecture + "\"\n"
+           "        task: \"Potentials\"\n" + options +
+           "    }\n";
+}
+
+/** Baseline, scheduled weights, bit-serial activations and weights, and small buffers */
+const std::vector<std::string> CYCLES = {
+    experiment("DaDianNao", "        tactical: false\n", "1GiB", "1GiB", "16GiB"),
+    experiment("DaDianNao", "        tactical: true\n        lookahead_h: 2\n        lookaside_d: 5\n"
+            "        search_shape: 'T'\n", "1GiB", "1GiB", "16GiB"),
+    experiment("Laconic", "        booth_encoding: true\n", "1GiB", "1GiB", "16GiB"),
+    experiment("DaDianNao", "        tactical: false\n", "4KiB", "4KiB", "16GiB")
+};
+
+/** Work reduction of every architecture */
+const std::vector<std::string> POTENTIALS = {
+    potentials("DaDianNao", "        tactical: false\n"),
+    potentials("DaDianNao", "        tactical: true\n        lookahead_h: 2\n        lookaside_d: 5\n"
+            "        search_shape: 'T'\n"),
+    potentials("Stripes", ""),
+    potentials("ShapeShifter", "        group_size: 1\n        column_registers: 0\n        minor_bit: false\n"
+            "        tactical: false\n"),
+    potentials("Loom", "        group_size: 1\n        pe_serial_bits: 1\n        minor_bit: false\n"
+            "        dynamic_weights: true\n"),
+    potentials("BitPragmatic", "        bits_first_stage: 0\n        column_registers: 0\n"
+            "        booth_encoding: true\n        tactical: false\n"),
+    potentials("Laconic", "        booth_encoding: true\n")
+};
+
+/** SCNN with the tiles of every layer in one group of output channels and in several groups */
+const std::vector<std::string> SCNN = {
+    potentials("SCNN", ""),
+    "    experiment {\n"
+    "        architecture: \"SCNN\"\n"
+    "        task: \"Cycles\"\n"
+    "        Wt: 4\n"
+    "        Ht: 4\n"
+    "        I: 4\n"
+    "        F: 4\n"
+    "        out_acc_size: 1024\n"
+    "        banks: 32\n"
+    "    }\n",
+    "    experiment {\n"
+    "        architecture: \"SCNN\"\n"
+    "        task: \"Cycles\"\n"
+    "        Wt: 2\n"
+    "        Ht: 2\n"
+    "        I: 4\n"
+    "        F: 4\n"
+    "        out_acc_size: 32\n"
+    "        banks: 32\n"
+    "    }\n"
+};
+
+/** The weight buffer of the first experiment is too small for the last two layers, so it fails in some shards */
+const std::vector<std::string> FAILING = {
+    experiment("DaDianNao", "        tactical: false\n", "1GiB", "192B", "16GiB"),
+    CYCLES[1],
+    CYCLES[2]
+};
+
+/**
+ * Experiments with two DRAM sizes in between, only the experiments with the same DRAM run concurrently. The DRAM
+ * size is not part of the results name, so the buffers are different too
+ */
+const std::vector<std::string> DRAM_GROUPS = {
+    CYCLES[0],
+    experiment("DaDianNao", "        tactical: false\n", "2GiB", "2GiB", "8GiB"),
+    CYCLES[1],
+    experiment("Laconic", "        booth_encoding: true\n", "2GiB", "2GiB", "8GiB"),
+    CYCLES[2],
+    experiment("DaDianNao", "        tactical: false\n", "8KiB", "8KiB", "8GiB"),
+    CYCLES[3]
+};
+
+/**
+ * Write the batch file
+ * @param experiments   Experiments of the batch
+ */
+void write_batch(const std::vector<std::string> &experiments) {
+    std::ofstream batch("batch");
+    batch << "simulate {\n"
+             "    network: \"" + NETWORK + "\"\n"
+             "    model: \"CSV\"\n"
+             "    data_type: \"Fixed\"\n";
+    for (const auto &exp : experiments) batch << exp;
+    batch << "}\n";
+}
+
+/**
+ * Run the simulator
+ * @param dnnsim    Simulator binary
+ * @param options   Command line options
+ * @return Exit status of the simulator
+ */
+int run(const std::string &dnnsim, const std::string &options) {
+    auto command = dnnsim + " " + options + " -q > simulation.log 2>&1";
+    auto status = std::system(command.c_str());
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/**
+ * Run the simulator and check that every experiment succeeded
+ * @param dnnsim    Simulator binary
+ * @param options   Command line options
+ */
+void simulate(const std::string &dnnsim, const std::string &options) {
+    if (run(dnnsim, options) != 0)
+        throw std::runtime_error("Command failed, output in simulation.log: " + dnnsim + " " + options);
+}
+
+/**
+ * Run the simulator and check that its exit status reports the failed experiments
+ * @param dnnsim    Simulator binary
+ * @param options   Command line options
+ * @return Number of errors
+ */
+int simulate_failing(const std::string &dnnsim, const std::string &options) {
+    if (run(dnnsim, options) != 0) return 0;
+    std::cerr << options << ": exit status 0 with a failed experiment" << std::endl;
+    return 1;
+}
+
+/**
+ * Return the files of the results folder of the network
+ * @return Names of the files
+ */
+std::vector<std::string> result_files() {
+    std::vector<std::string> files;
+    DIR *dir = opendir(("results/" + NETWORK).c_str());
+    if (dir == nullptr) return files;
+
+    while (auto entry = readdir(dir)) {
+        std::string file = entry->d_name;
+        if (file != "." && file != "..") files.push_back(file);
+    }
+    closedir(dir);
+    return files;
+}
+
+/** Remove the results of the network left by previous runs */
+void clear_results() {
+    for (const auto &file : result_files())
+        std::remove(("results/" + NETWORK + "/" + file).c_str());
+}
+
+/**
+ * Read the results of the network and remove them
+ * @return Contents of every csv file
+ */
+std::map<std::string, std::string> take_results() {
+    std::map<std::string, std::string> results;
+    for (const auto &file : result_files()) {
+        if (file.size() > 4 && file.compare(file.size() - 4, 4, ".csv") == 0) {
+            std::ifstream stream("results/" + NETWORK + "/" + file);
+            std::stringstream contents;
+            contents << stream.rdbuf();
+            results[file] = contents.str();
+        }
+    }
+    clear_results();
+
+    if (results.empty())
+        throw std::runtime_error("No results found in results/" + NETWORK);
+
+    return results;
+}
+
+/**
+ * Compare the results with the ones of the reference run
+ * @param reference Results of the reference run
+ * @param results   Results to check
+ * @param run       Description of the run
+ * @return Number of files that differ
+ */
+int compare(const std::map<std::string, std::string> &reference, const std::map<std::string, std::string> &results,
+        const std::string &run) {
+    int errors = 0;
+    for (const auto &result : reference) {
+        auto it = results.find(result.first);
+        if (it == results.end()) {
+            std::cerr << run << ": missing " << result.first << std::endl;
+            errors++;
+        } else if (it->second != result.second) {
+            std::cerr << run << ": " << result.first << " differs from a single run" << std::endl;
+            errors++;
+        }
+    }
+    for (const auto &result : results) {
+        if (reference.find(result.first) == reference.end()) {
+            std::cerr << run << ": " << result.first << " is not written by a single run" << std::endl;
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <DNNsim binary> threads|shards|jobs|workers|values" << std::endl;
+        return 1;
+    }
+
+    std::string dnnsim = argv[1];
+    std::string check = argv[2];
+
+    try {
+        write_network();
+        clear_results();
+
+        int errors = 0;
+        if (check == "threads") {
+            // With more threads than samples SCNN evaluates the PEs of the grid in parallel instead of the tiles
+            for (const auto &experiments : {CYCLES, POTENTIALS, SCNN}) {
+                write_batch(experiments);
+                simulate(dnnsim, "batch --threads 1");
+                auto reference = take_results();
+                for (auto threads : {2, 3, 5}) {
+                    simulate(dnnsim, "batch --threads " + std::to_string(threads));
+                    errors += compare(reference, take_results(), std::to_string(threads) + " threads");
+                }
+            }
+
+        } else if (check == "shards") {
+            write_batch(CYCLES);
+            simulate(dnnsim, "batch");
+            auto reference = take_results();
+            for (auto shards : {2, 3}) {
+                for (int shard = 0; shard < shards; ++shard)
+                    simulate(dnnsim, "batch --shard " + std::to_string(shard) + "/" + std::to_string(shards));
+                simulate(dnnsim, "--merge " + std::to_string(shards));
+                errors += compare(reference, take_results(), std::to_string(shards) + " shards");
+            }
+
+            // The failed experiment misses the partial results of some shards, the others are merged anyway
+            write_batch(FAILING);
+            run(dnnsim, "batch");
+            reference = take_results();
+            for (int shard = 0; shard < 4; ++shard)
+                run(dnnsim, "batch --shard " + std::to_string(shard) + "/4");
+            errors += simulate_failing(dnnsim, "--merge 4");
+            errors += compare(reference, take_results(), "4 shards with a failed experiment");
+
+        } else if (check == "jobs") {
+            write_batch(DRAM_GROUPS);
+            simulate(dnnsim, "batch --threads 1 --jobs 1");
+            auto reference = take_results();
+            for (const auto &options : {"--jobs 2", "--jobs 3 --threads 2"}) {
+                simulate(dnnsim, std::string("batch ") + options);
+                errors += compare(reference, take_results(), options);
+            }
+
+        } else if (check == "workers") {
+            write_batch(CYCLES);
+            simulate(dnnsim, "batch");
+            auto reference = take_results();
+            for (auto workers : {2, 3}) {
+                simulate(dnnsim, "batch --workers " + std::to_string(workers));
+                errors += compare(reference, take_results(), std::to_string(workers) + " workers");
+            }
+
+            // The worker with the failed experiment exits with an error, the others write their results
+            write_batch(FAILING);
+            errors += simulate_failing(dnnsim, "batch");
+            reference = take_results();
+            errors += simulate_failing(dnnsim, "batch --workers 2");
+            errors += compare(reference, take_results(), "2 workers with a failed experiment");
+
+        } else if (check == "values") {
+            // The background checks of the layers share the threads, a wrong output value fails the experiment
+            write_batch(CYCLES);
+            simulate(dnnsim, "batch");
+            auto reference = take_results();
+            simulate(dnnsim, "batch --check_values --threads 3");
+            errors += compare(reference, take_results(), "3 threads checking the values");
+
+        } else {
+            throw std::runtime_error("Unknown check " + check);
+        }
+
+        return errors == 0 ? 0 : 1;
+
+    } catch (std::exception &exception) {
+        std::cerr << "Error: " << exception.what() << std::endl;
+        return 1;
+    }
+
+}